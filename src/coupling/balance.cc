@@ -117,6 +117,7 @@ Balance::~Balance()
 		chkerr(VecDestroy(&(be_flux_vec_[c])));
         chkerr(VecDestroy(&(region_mass_vec_[c])));
 	}
+	chkerr(VecDestroy(&be_flux_tmp_));
 	delete[] region_mass_matrix_;
 	delete[] be_flux_matrix_;
 	delete[] be_flux_vec_;
@@ -329,6 +330,9 @@ void Balance::lazy_initialize()
 				&(be_flux_vec_[c])));
 	}
 
+	// work vector of boundary edge fluxes, shared by all quantities
+	chkerr(VecDuplicate(be_flux_vec_[0], &be_flux_tmp_));
+
 	// set be_offset_, used in add_flux_matrix_values()
 	chkerr(VecGetOwnershipRange(be_flux_vec_[0], &be_offset_, NULL));
     
@@ -580,24 +584,22 @@ void Balance::calculate_cumulative(unsigned int quantity_idx,
     increment_sources_[quantity_idx] += temp_source*time_->dt();
 
     
-    // fluxes     
-	Vec temp;
-    chkerr(VecCreateMPI(PETSC_COMM_WORLD,
-			be_regions_.size(),
-			PETSC_DECIDE,
-			&temp));
-    
-	chkerr(MatMultAdd(be_flux_matrix_[quantity_idx], solution, be_flux_vec_[quantity_idx], temp));
-	
-    double sum_fluxes;
-	chkerr(VecSum(temp, &sum_fluxes));
-	chkerr(VecDestroy(&temp));
+    // fluxes
+	chkerr(MatMultAdd(be_flux_matrix_[quantity_idx], solution, be_flux_vec_[quantity_idx], be_flux_tmp_));
 
-	if (rank_ == 0)
-		// sum fluxes in one step
-        // Since internally we keep outgoing fluxes, we change sign
-        // to write to output _incoming_ fluxes.
-		increment_fluxes_[quantity_idx] += -1.0 * sum_fluxes*time_->dt();
+	// Only the local part is summed here, the global sum is postponed
+	// to the single reduction in output(), together with the sources.
+	const double *flux_array;
+	double sum_fluxes = 0;
+	chkerr(VecGetArrayRead(be_flux_tmp_, &flux_array));
+	for (unsigned int e=0; e<be_regions_.size(); ++e)
+		sum_fluxes += flux_array[e];
+	chkerr(VecRestoreArrayRead(be_flux_tmp_, &flux_array));
+
+	// sum fluxes in one step
+	// Since internally we keep outgoing fluxes, we change sign
+	// to write to output _incoming_ fluxes.
+	increment_fluxes_[quantity_idx] += -1.0 * sum_fluxes*time_->dt();
 }
 
 
@@ -670,33 +672,25 @@ void Balance::calculate_instant(unsigned int quantity_idx, const Vec& solution)
     chkerr(VecRestoreArrayRead(solution, &sol_array));
     
     // calculate flux
-	Vec temp;
-    chkerr(VecCreateMPI(PETSC_COMM_WORLD,
-			be_regions_.size(),
-			PETSC_DECIDE,
-			&temp));
-    
-	chkerr(MatMultAdd(be_flux_matrix_[quantity_idx], solution, be_flux_vec_[quantity_idx], temp));
-	// Since internally we keep outgoing fluxes, we change sign
-	// to write to output _incoming_ fluxes.
-	chkerr(VecScale(temp, -1));
+	chkerr(MatMultAdd(be_flux_matrix_[quantity_idx], solution, be_flux_vec_[quantity_idx], be_flux_tmp_));
 
 	// compute positive/negative fluxes
 	fluxes_in_[quantity_idx].assign(mesh_->region_db().boundary_size(), 0);
 	fluxes_out_[quantity_idx].assign(mesh_->region_db().boundary_size(), 0);
+	// Since internally we keep outgoing fluxes, we change sign
+	// to write to output _incoming_ fluxes.
 	const double *flux_array;
-// 	int lsize;
-	chkerr(VecGetArrayRead(temp, &flux_array));
-	chkerr(VecGetLocalSize(temp, &lsize));
+	chkerr(VecGetArrayRead(be_flux_tmp_, &flux_array));
+	chkerr(VecGetLocalSize(be_flux_tmp_, &lsize));
 	for (int e=0; e<lsize; ++e)
 	{
-		if (flux_array[e] < 0)
-			fluxes_out_[quantity_idx][be_regions_[e]] += flux_array[e];
+		double flux = -flux_array[e];
+		if (flux < 0)
+			fluxes_out_[quantity_idx][be_regions_[e]] += flux;
 		else
-			fluxes_in_[quantity_idx][be_regions_[e]] += flux_array[e];
+			fluxes_in_[quantity_idx][be_regions_[e]] += flux;
 	}
-	chkerr(VecRestoreArrayRead(temp, &flux_array));
-	chkerr(VecDestroy(&temp));
+	chkerr(VecRestoreArrayRead(be_flux_tmp_, &flux_array));
 }
 
 
@@ -713,8 +707,11 @@ void Balance::output()
     const unsigned int n_quant = quantities_.size();
 	const unsigned int n_blk_reg = mesh_->region_db().bulk_size();
 	const unsigned int n_bdr_reg = mesh_->region_db().boundary_size();
-	const int buf_size = n_quant*2*n_blk_reg + n_quant*2*n_bdr_reg + n_quant;
-	double sendbuffer[buf_size], recvbuffer[buf_size];
+	// all quantities are gathered by a single reduction, including the cumulative
+	// increments of sources and fluxes summed locally in calculate_cumulative()
+	const unsigned int cumul_offset = n_quant*2*n_blk_reg + n_quant*2*n_bdr_reg;
+	const int buf_size = cumul_offset + 2*n_quant;
+	std::vector<double> sendbuffer(buf_size, 0), recvbuffer(buf_size, 0);
 	for (unsigned int qi=0; qi<n_quant; qi++)
 	{
 		for (unsigned int ri=0; ri<n_blk_reg; ri++)
@@ -729,11 +726,12 @@ void Balance::output()
 		}
 		if (cumulative_)
         {
-            sendbuffer[n_quant*2*n_blk_reg + n_quant*2*n_bdr_reg + qi] = increment_sources_[qi];
+            sendbuffer[cumul_offset +           qi] = increment_sources_[qi];
+            sendbuffer[cumul_offset + n_quant + qi] = increment_fluxes_[qi];
         }
 	}
     
-	MPI_Reduce(&sendbuffer,recvbuffer,buf_size,MPI_DOUBLE,MPI_SUM,0,PETSC_COMM_WORLD);
+	MPI_Reduce(sendbuffer.data(),recvbuffer.data(),buf_size,MPI_DOUBLE,MPI_SUM,0,PETSC_COMM_WORLD);
 	// for other than 0th process update last_time and finish,
 	// on process #0 sum balances over all regions and calculate
 	// cumulative balance over time.
@@ -754,7 +752,8 @@ void Balance::output()
 			}
 			if (cumulative_)
             {
-                increment_sources_[qi] = recvbuffer[n_quant*2*n_blk_reg + n_quant*2*n_bdr_reg + qi];
+                increment_sources_[qi] = recvbuffer[cumul_offset +           qi];
+                increment_fluxes_[qi]  = recvbuffer[cumul_offset + n_quant + qi];
             }
 		}
 	}
@@ -840,8 +839,8 @@ void Balance::output()
 	{
 		sum_fluxes_.assign(n_quant, 0);
 		sum_sources_.assign(n_quant, 0);
-		increment_fluxes_.assign(n_quant, 0);
 	}
+	increment_fluxes_.assign(n_quant, 0);
 	increment_sources_.assign(n_quant, 0);
 }
 
@@ -351,6 +351,8 @@ public:
 	 * Updates cumulative quantities for balance.
 	 * This method can be called in substeps even if no output is generated.
 	 * It calculates the sum of source and sum of (incoming) flux over time interval.
+	 * No global communication is performed, the local increments are summed up
+	 * over processes in the next call of output().
 	 * @param quantity_idx  Index of quantity.
 	 * @param solution      Solution vector.
 	 */
@@ -478,6 +480,9 @@ private:
     /// Vectors for calculation of mass (n_bulk_regions).
     Vec *region_mass_vec_;
 
+    /// Work vector of (outgoing) fluxes per boundary edge (n_boundary_edges), reused for all quantities.
+    Vec be_flux_tmp_;
+
     /** Maps unique identifier of (local bulk element idx, side idx) returned by @p get_boundary_edge_uid(side)
      * to local boundary edge.
      * Example usage:
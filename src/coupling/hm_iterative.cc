@@ -56,6 +56,19 @@ const it::Record & HM_Iterative::get_input_type() {
                 "Absolute tolerance for difference in HM iteration." )
         .declare_key( "r_tol", it::Double(0), it::Default("1e-7"),
                 "Relative tolerance for difference in HM iteration." )
+        .declare_key( "acceleration", HM_Iterative::get_acceleration_selection(), it::Default("\"none\""),
+                "Acceleration of the HM iteration applied to the divergence of displacement passed to the flow." )
+        .declare_key( "acceleration_depth", it::Integer(1), it::Default("5"),
+                "Number of previous iterations used by the Anderson acceleration." )
+		.close();
+}
+
+
+const it::Selection & HM_Iterative::get_acceleration_selection() {
+	return it::Selection("HM_Acceleration")
+		.add_value(no_acceleration, "none", "Plain fixed-point iteration.")
+		.add_value(aitken, "aitken", "Aitken dynamic relaxation.")
+		.add_value(anderson, "anderson", "Anderson mixing of ``acceleration_depth`` previous iterations.")
 		.close();
 }
 
@@ -144,6 +157,8 @@ HM_Iterative::HM_Iterative(Mesh &mesh, Input::Record in_record)
     
     // read parameters controlling the iteration
     beta_ = in_record.val<double>("iteration_parameter");
+    acceleration_ = in_record.val<AccelerationType>("acceleration");
+    acceleration_depth_ = in_record.val<unsigned int>("acceleration_depth");
 
     this->eq_data_ = &data_;
     
@@ -152,6 +167,18 @@ HM_Iterative::HM_Iterative(Mesh &mesh, Input::Record in_record)
 
     data_.initialize(*mesh_);
     mechanics_->set_potential_load(data_.pressure_potential);
+
+    if (acceleration_ != no_acceleration) {
+        auto dh = data_.div_u_ptr_->get_dofhandler();
+        accel_x_ = dh->create_vector();
+        accel_f_prev_ = dh->create_vector();
+        accel_g_prev_ = dh->create_vector();
+        if (acceleration_ == anderson)
+            for (unsigned int i=0; i<acceleration_depth_; ++i) {
+                accel_df_.push_back(dh->create_vector());
+                accel_dg_.push_back(dh->create_vector());
+            }
+    }
 }
 
 
@@ -170,6 +197,8 @@ void copy_field(const FieldCommon &from_field_common, FieldFE<dim, Value> &to_fi
     
     for ( auto cell : dh->own_range() )
         vec[cell.local_idx()] = from_field.value(cell.elm().centre(), cell.elm());
+    vec.local_to_ghost_begin();
+    vec.local_to_ghost_end();
 }
 
 
@@ -197,6 +226,7 @@ void HM_Iterative::update_solution()
     time_->view("HM");
     data_.set_time(time_->step(), LimitSide::right);
 
+    reset_acceleration();
     solve_step();
 }
 
@@ -216,7 +246,11 @@ void HM_Iterative::solve_iteration()
 void HM_Iterative::update_after_iteration()
 {
     mechanics_->update_output_fields();
+    if (acceleration_ != no_acceleration)
+        accel_x_.copy_from(data_.div_u_ptr_->vec());
     copy_field(mechanics_->data().output_divergence, *data_.div_u_ptr_);
+    if (acceleration_ != no_acceleration)
+        accelerate(accel_x_);
     copy_field(*flow_->data().field("pressure_p0"), *data_.old_iter_pressure_ptr_);
 }
 
@@ -320,6 +354,98 @@ void HM_Iterative::compute_iteration_error(double& abs_error, double& rel_error)
 
 
 
+void HM_Iterative::reset_acceleration()
+{
+    n_accel_iter_ = 0;
+    aitken_omega_ = 1.0;
+}
+
+
+void HM_Iterative::accelerate(VectorMPI &x)
+{
+    START_TIMER("HM acceleration");
+    // g = G(x) is the result of the last iteration, it is replaced by the accelerated value;
+    // residual f = g - x is stored in x
+    VectorMPI &g = data_.div_u_ptr_->vec();
+    VectorMPI &f = x;
+    auto dh = data_.div_u_ptr_->get_dofhandler();
+    std::vector<unsigned int> own_dofs;
+    own_dofs.reserve(dh->own_size());
+    for (auto cell : dh->own_range()) own_dofs.push_back(cell.local_idx());
+
+    for (unsigned int i : own_dofs) f[i] = g[i] - f[i];
+
+    if (n_accel_iter_ > 0 && acceleration_ == aitken)
+    {
+        // omega_k = -omega_{k-1} * f_{k-1}.(f_k - f_{k-1}) / |f_k - f_{k-1}|^2
+        double loc_dots[2] = {0, 0}, dots[2];
+        for (unsigned int i : own_dofs) {
+            double df = f[i] - accel_f_prev_[i];
+            loc_dots[0] += accel_f_prev_[i] * df;
+            loc_dots[1] += df * df;
+        }
+        MPI_Allreduce(loc_dots, dots, 2, MPI_DOUBLE, MPI_SUM, PETSC_COMM_WORLD);
+        if (dots[1] > 0) aitken_omega_ = -aitken_omega_ * dots[0] / dots[1];
+
+        for (unsigned int i : own_dofs) accel_f_prev_[i] = f[i];
+        // x_{k+1} = x_k + omega f_k = g_k - (1-omega) f_k
+        for (unsigned int i : own_dofs) g[i] -= (1.0 - aitken_omega_) * f[i];
+    }
+    else if (n_accel_iter_ > 0 && acceleration_ == anderson)
+    {
+        // store new differences into the ring buffer, save f_k, g_k
+        unsigned int i_new = (n_accel_iter_-1) % acceleration_depth_;
+        for (unsigned int i : own_dofs) {
+            accel_df_[i_new][i] = f[i] - accel_f_prev_[i];
+            accel_dg_[i_new][i] = g[i] - accel_g_prev_[i];
+            accel_f_prev_[i] = f[i];
+            accel_g_prev_[i] = g[i];
+        }
+
+        // least squares problem min |f_k - dF gamma|, solved through normal equations;
+        // all scalar products are reduced at once: dF'dF (m x m) and dF'f (m)
+        unsigned int m = std::min(n_accel_iter_, acceleration_depth_);
+        std::vector<double> loc_dots(m*m + m, 0.0), dots(m*m + m);
+        for (unsigned int k=0; k<m; ++k) {
+            for (unsigned int l=0; l<=k; ++l)
+                for (unsigned int i : own_dofs) loc_dots[k*m+l] += accel_df_[k][i] * accel_df_[l][i];
+            for (unsigned int i : own_dofs) loc_dots[m*m+k] += accel_df_[k][i] * f[i];
+        }
+        MPI_Allreduce(&loc_dots[0], &dots[0], m*m + m, MPI_DOUBLE, MPI_SUM, PETSC_COMM_WORLD);
+
+        arma::mat dfdf(m,m);
+        arma::vec dff(m), gamma;
+        for (unsigned int k=0; k<m; ++k) {
+            dff(k) = dots[m*m+k];
+            for (unsigned int l=0; l<=k; ++l) dfdf(k,l) = dfdf(l,k) = dots[k*m+l];
+        }
+        // singular system (stagnation) falls back to the plain iteration
+        if (arma::solve(gamma, dfdf, dff, arma::solve_opts::no_approx))
+        {
+            // x_{k+1} = g_k - dG gamma
+            for (unsigned int k=0; k<m; ++k)
+                for (unsigned int i : own_dofs) g[i] -= gamma(k) * accel_dg_[k][i];
+        }
+    }
+    else
+    {
+        // first iteration of the time step: plain fixed point update
+        for (unsigned int i : own_dofs) {
+            accel_f_prev_[i] = f[i];
+            accel_g_prev_[i] = g[i];
+        }
+    }
+
+    // accelerated values are computed on own dofs, ghost values are read in update_flow_fields();
+    // the history vectors f, g, dF, dG are accessed only on own dofs
+    g.local_to_ghost_begin();
+    g.local_to_ghost_end();
+
+    n_accel_iter_++;
+}
+
+
+
 HM_Iterative::~HM_Iterative() {
 	flow_.reset();
     mechanics_.reset();
@@ -27,6 +27,7 @@
 #include "coupling/equation.hh"
 #include "flow/darcy_flow_interface.hh"
 #include "mechanics/elasticity.hh"
+#include "la/vector_mpi.hh"
 
 class Mesh;
 class FieldCommon;
@@ -149,9 +150,19 @@ public:
         std::shared_ptr<FieldFE<3, FieldValue<3>::Scalar> > old_div_u_ptr_;
     };
     
+    /// Acceleration of the fixed-stress iteration.
+    enum AccelerationType {
+        no_acceleration,
+        aitken,     ///< Aitken dynamic relaxation.
+        anderson    ///< Anderson mixing with limited history.
+    };
+
     /// Define input record.
     static const Input::Type::Record & get_input_type();
 
+    /// Selection for enum AccelerationType.
+    static const Input::Type::Selection & get_acceleration_selection();
+
     HM_Iterative(Mesh &mesh, Input::Record in_record);
     void initialize() override;
     void zero_time_step() override;
@@ -171,6 +182,16 @@ private:
     void update_after_converged() override;
     
     void compute_iteration_error(double &abs_error, double &rel_error) override;
+
+    /// Clear history of the acceleration (at the beginning of each time step).
+    void reset_acceleration();
+
+    /**
+     * Modify the divergence of displacement passed to the flow in the next iteration.
+     * @p x is the input of the last iteration, div_u_ptr_ holds its result which is
+     * replaced by the accelerated value.
+     */
+    void accelerate(VectorMPI &x);
     
     static const int registrar;
 
@@ -184,6 +205,24 @@ private:
 
     /// Tuning parameter for iterative splitting.
     double beta_;
+
+    /// Type of acceleration of the iteration.
+    AccelerationType acceleration_;
+
+    /// Number of previous iterations used in the Anderson mixing.
+    unsigned int acceleration_depth_;
+
+    /// Number of iterations processed by the acceleration in the current time step.
+    unsigned int n_accel_iter_;
+
+    /// Aitken relaxation factor.
+    double aitken_omega_;
+
+    /// Input of the current iteration, residual and result of the previous one.
+    VectorMPI accel_x_, accel_f_prev_, accel_g_prev_;
+
+    /// Anderson history: differences of residuals and results (ring buffers).
+    std::vector<VectorMPI> accel_df_, accel_dg_;
     
 };
 
@@ -56,7 +56,7 @@ public:
 
     /// Return local index to element (index of DOF handler).
     inline unsigned int local_idx() const {
-        ASSERT_LT_DBG(loc_ele_idx_, dof_handler_->global_to_local_el_idx_.size()).error("Local element index is out of range!\n");
+        ASSERT_LT_DBG(loc_ele_idx_, dof_handler_->local_size()).error("Local element index is out of range!\n");
         return loc_ele_idx_;
     }
 
@@ -413,8 +413,7 @@ public:
 private:
     /// Check if cell side of neighbour is not local (allow skip invalid accessors).
     inline bool not_local_cell() {
-        return ( dh_cell_.dof_handler_->global_to_local_el_idx_.end() ==
-            dh_cell_.dof_handler_->global_to_local_el_idx_.find((LongIdx)dh_cell_.elm()->neigh_vb[neighb_idx_]->side()->elem_idx()) );
+        return ( dh_cell_.dof_handler_->global_to_local_el_idx_[ dh_cell_.elm()->neigh_vb[neighb_idx_]->side()->elem_idx() ] == -1 );
     }
 
     /// Appropriate cell accessor.
@@ -28,6 +28,50 @@
 #include "mesh/range_wrapper.hh"
 #include "mesh/neighbours.h"
 #include "la/distribution.hh"
+#include "fem/mapping_p1.hh"
+
+
+namespace {
+
+/**
+ * Exchange vectors of indices with all neighbouring processors @p procs in one round
+ * of non-blocking communication. Vectors in @p recv_data must have the size of received
+ * data, unless @p exchange_sizes is true. Then sizes are exchanged in a preceding round.
+ */
+void exchange_indices(const set<unsigned int> &procs,
+                      map<unsigned int, vector<LongIdx> > &send_data,
+                      map<unsigned int, vector<LongIdx> > &recv_data,
+                      int tag,
+                      bool exchange_sizes)
+{
+    vector<MPI_Request> requests(2*procs.size());
+    unsigned int i_req;
+
+    if (exchange_sizes)
+    {
+        map<unsigned int, unsigned int> send_size, recv_size;
+        i_req = 0;
+        for (unsigned int proc : procs)
+        {
+            send_size[proc] = send_data[proc].size();
+            MPI_Irecv(&recv_size[proc], 1, MPI_UNSIGNED, proc, tag, MPI_COMM_WORLD, &requests[i_req++]);
+            MPI_Isend(&send_size[proc], 1, MPI_UNSIGNED, proc, tag, MPI_COMM_WORLD, &requests[i_req++]);
+        }
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        for (unsigned int proc : procs)
+            recv_data[proc].resize(recv_size[proc]);
+    }
+
+    i_req = 0;
+    for (unsigned int proc : procs)
+    {
+        MPI_Irecv(recv_data[proc].data(), recv_data[proc].size(), MPI_LONG_IDX, proc, tag+1, MPI_COMM_WORLD, &requests[i_req++]);
+        MPI_Isend(send_data[proc].data(), send_data[proc].size(), MPI_LONG_IDX, proc, tag+1, MPI_COMM_WORLD, &requests[i_req++]);
+    }
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+}
 
 
 const int DOFHandlerMultiDim::INVALID_NFACE  = 1;
@@ -158,61 +202,34 @@ void DOFHandlerMultiDim::init_status(
 }
 
 
-void DOFHandlerMultiDim::receive_ghost_dofs(unsigned int proc, vector<LongIdx> &dofs)
-{
-    // send number of elements required from the other processor
-    unsigned int n_elems = ghost_proc_el[proc].size();
-    MPI_Send(&n_elems, 1, MPI_UNSIGNED, proc, 0, MPI_COMM_WORLD);
-    
-    // send indices of elements required
-    MPI_Send(&(ghost_proc_el[proc][0]), n_elems, MPI_LONG_IDX, proc, 1, MPI_COMM_WORLD);
-    
-    // receive numbers of dofs on required elements
-    vector<unsigned int> n_dofs(n_elems);
-    MPI_Recv(&(n_dofs[0]), n_elems, MPI_UNSIGNED, proc, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-    
-    // receive dofs on required elements
-    unsigned int n_dofs_sum = 0;
-    for (auto nd : n_dofs) n_dofs_sum += nd;
-    dofs.resize(n_dofs_sum);
-    MPI_Recv(&(dofs[0]), n_dofs_sum, MPI_LONG_IDX, proc, 3, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-}
-
-
-void DOFHandlerMultiDim::send_ghost_dofs(unsigned int proc)
+void DOFHandlerMultiDim::get_requested_dofs(const std::vector<LongIdx> &elems, std::vector<LongIdx> &dofs) const
 {
-    // receive number of elements required by the other processor
-    unsigned int n_elems;
-    MPI_Recv(&n_elems, 1, MPI_UNSIGNED, proc, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-    
-    // receive indices of elements required
-    vector<LongIdx> elems(n_elems);
-    MPI_Recv(&(elems[0]), n_elems, MPI_LONG_IDX, proc, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-    
-    // send numbers of dofs on required elements
-    vector<unsigned int> n_dofs;
+    // global dofs on the required own elements, INVALID_DOF if not known yet
+    dofs.clear();
     for (LongIdx el : elems)
     {
         auto cell = this->cell_accessor_from_element(el);
-        n_dofs.push_back(cell_starts[cell.local_idx()+1] - cell_starts[cell.local_idx()]);
+        for (LongIdx i=cell_starts[cell.local_idx()]; i<cell_starts[cell.local_idx()+1]; i++)
+            dofs.push_back( (dof_indices[i] == INVALID_DOF) ? (LongIdx)INVALID_DOF : local_to_global_dof_idx_[dof_indices[i]] );
     }
-    MPI_Send(&(n_dofs[0]), n_elems, MPI_UNSIGNED, proc, 2, MPI_COMM_WORLD);
-    
-    // send dofs on the required elements
-    vector<LongIdx> dofs;
-    for (LongIdx el : elems)
+}
+
+
+unsigned int DOFHandlerMultiDim::n_ghost_dofs(unsigned int proc) const
+{
+    unsigned int n_dofs = 0;
+    for (LongIdx el : ghost_proc_el.at(proc))
     {
         auto cell = this->cell_accessor_from_element(el);
-        for (LongIdx i=cell_starts[cell.local_idx()]; i<cell_starts[cell.local_idx()+1]; i++)
-            dofs.push_back(local_to_global_dof_idx_[dof_indices[i]]);
+        n_dofs += cell_starts[cell.local_idx()+1] - cell_starts[cell.local_idx()];
     }
-    MPI_Send(&(dofs[0]), dofs.size(), MPI_LONG_IDX, proc, 3, MPI_COMM_WORLD);
+    return n_dofs;
 }
 
 
-void DOFHandlerMultiDim::update_local_dofs(unsigned int proc,
-                                           const std::vector<bool> &update_cells,
-                                           const std::vector<LongIdx> &dofs, 
+void DOFHandlerMultiDim::update_ghost_dofs(unsigned int proc,
+                                           const std::vector<LongIdx> &dofs,
+                                           bool only_shared,
                                            const std::vector<LongIdx> &node_dof_starts,
                                            std::vector<LongIdx> &node_dofs,
                                            const std::vector<LongIdx> &edge_dof_starts,
@@ -228,18 +245,21 @@ void DOFHandlerMultiDim::update_local_dofs(unsigned int proc,
         vector<unsigned int> loc_edge_dof_count(dh_cell.elm()->n_sides(), 0);
         for (unsigned int idof = 0; idof<dh_cell.n_dofs(); ++idof)
         {
+            LongIdx global_dof = dofs[dof_offset+idof];
+            ASSERT_DBG(only_shared || global_dof != INVALID_DOF)(proc)(dh_cell.elm_idx()).error("Unknown dof on ghost cell.");
             if (dh_cell.cell_dof(idof).dim == 0)
             {   // update nodal dof
                 unsigned int dof_nface_idx = dh_cell.cell_dof(idof).n_face_idx;
                 unsigned int nid = mesh_->tree->objects(dh_cell.dim())[mesh_->tree->obj_4_el()[dh_cell.elm_idx()]].nodes[dof_nface_idx];
                 unsigned int node_dof_idx = node_dof_starts[nid]+loc_node_dof_count[dof_nface_idx];
                     
-                if (node_dofs[node_dof_idx] == INVALID_DOF)
+                if (node_dofs[node_dof_idx] == INVALID_DOF && global_dof != INVALID_DOF)
                 {
                     node_dofs[node_dof_idx] = local_to_global_dof_idx_.size();
-                    local_to_global_dof_idx_.push_back(dofs[dof_offset+idof]);
+                    local_to_global_dof_idx_.push_back(global_dof);
                 }
-                dof_indices[cell_starts[dh_cell.local_idx()]+idof] = node_dofs[node_dof_idx];
+                if (!only_shared)
+                    dof_indices[cell_starts[dh_cell.local_idx()]+idof] = node_dofs[node_dof_idx];
                 
                 loc_node_dof_count[dof_nface_idx]++;
             }
@@ -249,24 +269,33 @@ void DOFHandlerMultiDim::update_local_dofs(unsigned int proc,
                 unsigned int eid = dh_cell.elm().side(dof_nface_idx)->edge_idx();
                 unsigned int edge_dof_idx = edge_dof_starts[eid]+loc_edge_dof_count[dof_nface_idx];
                     
-                if (edge_dofs[edge_dof_idx] == INVALID_DOF)
+                if (edge_dofs[edge_dof_idx] == INVALID_DOF && global_dof != INVALID_DOF)
                 {
                     edge_dofs[edge_dof_idx] = local_to_global_dof_idx_.size();
-                    local_to_global_dof_idx_.push_back(dofs[dof_offset+idof]);
+                    local_to_global_dof_idx_.push_back(global_dof);
                 }
-                dof_indices[cell_starts[dh_cell.local_idx()]+idof] = edge_dofs[edge_dof_idx];
+                if (!only_shared)
+                    dof_indices[cell_starts[dh_cell.local_idx()]+idof] = edge_dofs[edge_dof_idx];
                 
                 loc_edge_dof_count[dof_nface_idx]++;
-            } else if (dh_cell.cell_dof(idof).dim == dh_cell.dim())
+            } else if (dh_cell.cell_dof(idof).dim == dh_cell.dim() && !only_shared)
             {
                 dof_indices[cell_starts[dh_cell.local_idx()]+idof] = local_to_global_dof_idx_.size();
-                local_to_global_dof_idx_.push_back(dofs[dof_offset+idof]);
+                local_to_global_dof_idx_.push_back(global_dof);
             }
         }
         
         dof_offset += dh_cell.n_dofs();
     }
-    
+}
+
+
+void DOFHandlerMultiDim::update_own_dofs(const std::vector<bool> &update_cells,
+                                         const std::vector<LongIdx> &node_dof_starts,
+                                         const std::vector<LongIdx> &node_dofs,
+                                         const std::vector<LongIdx> &edge_dof_starts,
+                                         const std::vector<LongIdx> &edge_dofs)
+{
     // update dof_indices on local elements
     for (auto cell : this->own_range())
     {
@@ -284,6 +313,7 @@ void DOFHandlerMultiDim::update_local_dofs(unsigned int proc,
                 {   // update nodal dof
                     unsigned int nid = mesh_->tree->objects(cell.dim())[mesh_->tree->obj_4_el()[cell.elm_idx()]].nodes[dof_nface_idx];
                     dof_indices[cell_starts[cell.local_idx()]+idof] = node_dofs[node_dof_starts[nid]+loc_node_dof_count[dof_nface_idx]];
+                    ASSERT_DBG(dof_indices[cell_starts[cell.local_idx()]+idof] != INVALID_DOF)(cell.elm_idx()).error("Unknown dof on own cell.");
                 }
                 loc_node_dof_count[dof_nface_idx]++;
             } else if (cell.cell_dof(idof).dim == cell.dim()-1)
@@ -292,6 +322,7 @@ void DOFHandlerMultiDim::update_local_dofs(unsigned int proc,
                 {   // update edge dof
                     unsigned int eid = cell.elm().side(dof_nface_idx)->edge_idx();
                     dof_indices[cell_starts[cell.local_idx()]+idof] = edge_dofs[edge_dof_starts[eid]+loc_edge_dof_count[dof_nface_idx]];
+                    ASSERT_DBG(dof_indices[cell_starts[cell.local_idx()]+idof] != INVALID_DOF)(cell.elm_idx()).error("Unknown dof on own cell.");
                 }
                 loc_edge_dof_count[dof_nface_idx]++;
             }
@@ -405,36 +436,65 @@ void DOFHandlerMultiDim::distribute_dofs(std::shared_ptr<DiscreteSpace> ds)
     }
     
     // communicate dofs from ghost cells
-    // first propagate from lower procs to higher procs and then vice versa
-    for (unsigned int from_higher = 0; from_higher < 2; from_higher++)
+    // Dofs on a node/edge are owned by the lowest processor whose cell contains it and this cell
+    // is a ghost cell of all other processors sharing the node/edge. Hence after the first round
+    // each processor knows all dofs of its own cells and after the second one all dofs of ghost cells.
+    // All neighbours are communicated at once, no processor waits for processors with lower rank.
+    map<unsigned int, vector<LongIdx> > requested_el, own_dofs, ghost_dofs;
+    exchange_indices(ghost_proc, ghost_proc_el, requested_el, 0, true);
+    for (unsigned int round = 0; round < 2; round++)
     {
         for (unsigned int proc : ghost_proc)
         {
-            if ((proc > el_ds_->myp()) == from_higher)
-            { // receive dofs from master processor
-                vector<LongIdx> dofs;
-                receive_ghost_dofs(proc, dofs);
-                
-                // update dof_indices and node_dofs on ghost elements
-                update_local_dofs(proc,
-                                  update_cells,
-                                  dofs,
-                                  node_dof_starts,
-                                  node_dofs,
-                                  edge_dof_starts,
-                                  edge_dofs
-                                 );
-                
-            }
-            else
-                send_ghost_dofs(proc);
+            get_requested_dofs(requested_el[proc], own_dofs[proc]);
+            ghost_dofs[proc].resize( n_ghost_dofs(proc) );
         }
+        exchange_indices(ghost_proc, own_dofs, ghost_dofs, 2+2*round, false);
+
+        // update dof_indices and node_dofs on ghost elements
+        bool only_shared = (round == 0);
+        for (unsigned int proc : ghost_proc)
+            update_ghost_dofs(proc,
+                              ghost_dofs[proc],
+                              only_shared,
+                              node_dof_starts,
+                              node_dofs,
+                              edge_dof_starts,
+                              edge_dofs
+                             );
+        if (only_shared) update_own_dofs(update_cells, node_dof_starts, node_dofs, edge_dof_starts, edge_dofs);
     }
     update_cells.clear();
     node_dofs.clear();
     node_dof_starts.clear();
     edge_dofs.clear();
     edge_dof_starts.clear();
+
+    init_interface_cells();
+}
+
+
+void DOFHandlerMultiDim::init_interface_cells()
+{
+    interior_cells_.clear();
+    interface_cells_.clear();
+    auto is_own_cell = [this](const DHCellAccessor &cell) -> bool
+    {
+        LocDofVec loc_dofs = cell.get_loc_dof_indices();
+        for (unsigned int i=0; i<loc_dofs.n_elem; i++)
+            if (loc_dofs[i] >= static_cast<int>(lsize_)) return false;
+        return true;
+    };
+
+    for (auto cell : this->own_range())
+    {
+        bool interior = is_own_cell(cell);
+        for (auto neighb_side : cell.neighb_sides())
+            interior = interior && is_own_cell(neighb_side.cell());
+
+        if (interior) interior_cells_.push_back(cell.local_idx());
+        else interface_cells_.push_back(cell.local_idx());
+    }
 }
 
 
@@ -467,6 +527,7 @@ void DOFHandlerMultiDim::create_sequential()
     MPI_MAX,
     MPI_COMM_WORLD);
 
+  dh_seq_->global_to_local_el_idx_.resize(mesh_->n_elements());
   for (unsigned int i=0; i<mesh_->n_elements(); i++) dh_seq_->global_to_local_el_idx_[i] = mesh_->get_row_4_el()[i];
   
   // Auxiliary vectors cell_starts_loc and dof_indices_loc contain
@@ -541,6 +602,68 @@ VectorMPI DOFHandlerMultiDim::create_vector()
 }
 
 
+template<unsigned int dim>
+arma::vec3 DOFHandlerMultiDim::dof_support_point(const DHCellAccessor &cell, unsigned int idof) const
+{
+    typename MappingP1<dim,3>::BaryPoint bary = cell.cell_dof(idof).coords;
+    return MappingP1<dim,3>::project_unit_to_real(bary, MappingP1<dim,3>::element_map(cell.elm()));
+}
+
+
+std::vector<double> DOFHandlerMultiDim::own_dof_coordinates() const
+{
+    std::vector<double> coords(3*lsize_, 0.0);
+    // own dofs may lie on ghost cells, so we pass through all local cells
+    for (auto cell : local_range())
+    {
+        LocDofVec loc_dofs = cell.get_loc_dof_indices();
+        for (unsigned int i=0; i<loc_dofs.n_elem; i++)
+        {
+            if (loc_dofs[i] >= static_cast<int>(lsize_)) continue;
+            arma::vec3 point;
+            switch (cell.dim()) {
+                case 1: point = dof_support_point<1>(cell, i); break;
+                case 2: point = dof_support_point<2>(cell, i); break;
+                case 3: point = dof_support_point<3>(cell, i); break;
+            }
+            for (unsigned int c=0; c<3; c++) coords[3*loc_dofs[i]+c] = point[c];
+        }
+    }
+    return coords;
+}
+
+
+std::vector<VectorMPI> DOFHandlerMultiDim::rigid_body_modes()
+{
+    std::vector<double> coords = own_dof_coordinates();
+    std::vector<VectorMPI> modes;
+    for (unsigned int i=0; i<6; i++) modes.push_back(create_vector());
+
+    for (auto cell : local_range())
+    {
+        LocDofVec loc_dofs = cell.get_loc_dof_indices();
+        for (unsigned int i=0; i<loc_dofs.n_elem; i++)
+        {
+            if (loc_dofs[i] >= static_cast<int>(lsize_)) continue;
+            const arma::vec &coefs = cell.cell_dof(i).coefs;
+            ASSERT_EQ_DBG(coefs.n_elem, 3).error("Rigid body modes are defined only for vector valued FE in 3D.");
+            arma::vec3 x(&coords[3*loc_dofs[i]]);
+            // translations
+            for (unsigned int k=0; k<3; k++)
+                modes[k][ loc_dofs[i] ] = coefs[k];
+            // rotations about coordinate axes: u = e_k x x
+            for (unsigned int k=0; k<3; k++)
+            {
+                arma::vec3 axis = arma::zeros<arma::vec>(3);
+                axis[k] = 1.0;
+                modes[3+k][ loc_dofs[i] ] = arma::dot(coefs, arma::cross(axis, x));
+            }
+        }
+    }
+    return modes;
+}
+
+
 unsigned int DOFHandlerMultiDim::get_dof_indices(const DHCellAccessor &cell, std::vector<LongIdx> &indices) const
 {
   unsigned int ndofs = 0;
@@ -587,6 +710,7 @@ void DOFHandlerMultiDim::make_elem_partitioning()
 	}
 	
     // init global to local element map with locally owned elements (later add ghost elements)
+    global_to_local_el_idx_.assign(mesh_->n_elements(), -1);
     for ( unsigned int iel = 0; iel < el_ds_->lsize(); iel++ )
         global_to_local_el_idx_[mesh_->get_el_4_loc()[iel]] = iel;
 	
@@ -624,7 +748,7 @@ void DOFHandlerMultiDim::make_elem_partitioning()
     for (auto nb : nb_4_loc)
     {
         auto cell = mesh_->vb_neighbours_[nb].element();
-        if (!el_is_local(cell.idx()) && find(ghost_4_loc.begin(), ghost_4_loc.end(), cell.idx()) == ghost_4_loc.end())
+        if (global_to_local_el_idx_[cell.idx()] == -1)
         {
             ghost_4_loc.push_back(cell.idx());
             ghost_proc.insert(cell.proc());
@@ -632,7 +756,7 @@ void DOFHandlerMultiDim::make_elem_partitioning()
             global_to_local_el_idx_[cell.idx()] = el_ds_->lsize() - 1 + ghost_4_loc.size();
         }
         cell = mesh_->vb_neighbours_[nb].side()->element();
-        if (!el_is_local(cell.idx()) && find(ghost_4_loc.begin(), ghost_4_loc.end(), cell.idx()) == ghost_4_loc.end())
+        if (global_to_local_el_idx_[cell.idx()] == -1)
         {
             ghost_4_loc.push_back(cell.idx());
             ghost_proc.insert(cell.proc());
@@ -676,9 +800,9 @@ Range<DHCellAccessor> DOFHandlerMultiDim::ghost_range() const {
 
 
 const DHCellAccessor DOFHandlerMultiDim::cell_accessor_from_element(unsigned int elm_idx) const {
-	auto map_it = global_to_local_el_idx_.find((LongIdx)elm_idx); // find in global to local map
-	ASSERT( map_it != global_to_local_el_idx_.end() )(elm_idx).error("DH accessor can be create only for own or ghost elements!\n");
-	return DHCellAccessor(this, map_it->second);
+	ASSERT( elm_idx < global_to_local_el_idx_.size() && global_to_local_el_idx_[elm_idx] != -1 )(elm_idx)
+	        .error("DH accessor can be create only for own or ghost elements!\n");
+	return DHCellAccessor(this, global_to_local_el_idx_[elm_idx]);
 }
 
 
@@ -712,7 +836,8 @@ void DOFHandlerMultiDim::print() const {
     s << "- ghost dofs (" << local_to_global_dof_idx_.size() - lsize_ << "): ";
     for (unsigned int i=lsize_; i<local_to_global_dof_idx_.size(); i++) s << local_to_global_dof_idx_[i] << " "; s << endl;
     s << "- global-to-local-cell map:" << endl;
-    for (auto cell : global_to_local_el_idx_) s << "-- " << cell.first << " -> " << cell.second << " " << endl;
+    for (unsigned int i=0; i<global_to_local_el_idx_.size(); i++)
+        if (global_to_local_el_idx_[i] != -1) s << "-- " << i << " -> " << global_to_local_el_idx_[i] << " " << endl;
     s << endl;
     
     printf("%s", s.str().c_str());
@@ -818,64 +943,36 @@ SubDOFHandlerMultiDim::SubDOFHandlerMultiDim(std::shared_ptr<DOFHandlerMultiDim>
       for (unsigned int i=0; i<lsize_; i++)
           local_to_global_dof_idx_[i] += loffset_;
     
-    // communicate ghost values
-    // first propagate from lower procs to higher procs and then vice versa
-    for (unsigned int from_higher = 0; from_higher < 2; from_higher++)
+    // communicate ghost values in one round with all neighbours:
+    // request global indices relative to the sub-handler from owners of ghost dofs
+    map<unsigned int, vector<LongIdx> > required_dofs, requested_dofs, sent_dofs, received_dofs;
+    vector<int> ghost_dof_proc(local_to_global_dof_idx_.size(), -1);
+    for (unsigned int i=lsize_; i<local_to_global_dof_idx_.size(); i++)
     {
-        for (unsigned int proc : ghost_proc)
+        LongIdx parent_dof = parent_->local_to_global_dof_idx_[parent_dof_idx_[i]];
+        unsigned int proc = parent_->dof_ds_->get_proc(parent_dof);
+        if (ghost_proc.find(proc) != ghost_proc.end())
         {
-            if ((proc > el_ds_->myp()) == from_higher)
-            { // receive dofs from master processor
-                vector<LongIdx> dofs;
-                receive_sub_ghost_dofs(proc, dofs);
-            }
-            else
-                send_sub_ghost_dofs(proc, global_to_local_dof_idx);
+            ghost_dof_proc[i] = proc;
+            required_dofs[proc].push_back(parent_dof);
         }
     }
-}
-
-
-void SubDOFHandlerMultiDim::receive_sub_ghost_dofs(unsigned int proc, vector<LongIdx> &dofs)
-{
-    // send number of ghost dofs required from the other processor
-    vector<LongIdx> dof_indices;
-    for (unsigned int i=lsize_; i<local_to_global_dof_idx_.size(); i++)
-        if (parent_->dof_ds_->get_proc(parent_->local_to_global_dof_idx_[parent_dof_idx_[i]]) == proc)
-            dof_indices.push_back(parent_->local_to_global_dof_idx_[parent_dof_idx_[i]]);
-    unsigned int n_ghosts = dof_indices.size();
-    MPI_Send(&n_ghosts, 1, MPI_UNSIGNED, proc, 0, MPI_COMM_WORLD);
-    
-    // send indices of dofs required
-    MPI_Send(dof_indices.data(), n_ghosts, MPI_LONG_IDX, proc, 1, MPI_COMM_WORLD);
-    
-    // receive dofs
-    dofs.resize(n_ghosts);
-    MPI_Recv(dofs.data(), n_ghosts, MPI_LONG_IDX, proc, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    exchange_indices(ghost_proc, required_dofs, requested_dofs, 0, true);
+    for (unsigned int proc : ghost_proc)
+    {
+        for (auto global_dof : requested_dofs[proc])
+            sent_dofs[proc].push_back(global_to_local_dof_idx.at(global_dof) + dof_ds_->begin());
+        received_dofs[proc].resize(required_dofs[proc].size());
+    }
+    exchange_indices(ghost_proc, sent_dofs, received_dofs, 2, false);
     
     // update ghost dofs
-    unsigned int idof = 0;
+    map<unsigned int, unsigned int> n_updated;
     for (unsigned int i=lsize_; i<local_to_global_dof_idx_.size(); i++)
-        if (parent_->dof_ds_->get_proc(parent_->local_to_global_dof_idx_[parent_dof_idx_[i]]) == proc)
-            local_to_global_dof_idx_[i] = dofs[idof++];
-}
-
+        if (ghost_dof_proc[i] >= 0)
+            local_to_global_dof_idx_[i] = received_dofs[ghost_dof_proc[i]][ n_updated[ghost_dof_proc[i]]++ ];
 
-void SubDOFHandlerMultiDim::send_sub_ghost_dofs(unsigned int proc, const map<LongIdx,LongIdx> &global_to_local_dof_idx)
-{
-    // receive number of dofs required by the other processor
-    unsigned int n_ghosts;
-    MPI_Recv(&n_ghosts, 1, MPI_UNSIGNED, proc, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-    
-    // receive global indices of dofs required
-    vector<LongIdx> dof_indices(n_ghosts);
-    MPI_Recv(dof_indices.data(), n_ghosts, MPI_LONG_IDX, proc, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-    
-    // send global dof indices relative to the sub-handler
-    vector<LongIdx> dofs;
-    for (auto global_dof : dof_indices)
-        dofs.push_back(global_to_local_dof_idx.at(global_dof) + dof_ds_->begin());
-    MPI_Send(dofs.data(), dofs.size(), MPI_LONG_IDX, proc, 2, MPI_COMM_WORLD);
+    init_interface_cells();
 }
 
 
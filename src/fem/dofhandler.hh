@@ -20,7 +20,6 @@
 #define DOFHANDLER_HH_
 
 #include <vector>                   // for vector
-#include <unordered_map>            // for unordered_map
 #include "system/index_types.hh"    // for LongIdx
 #include "mesh/mesh.h"
 #include "mesh/accessors.hh"
@@ -233,6 +232,20 @@ public:
     /// Returns range over ghosts DOF handler cells
     Range<DHCellAccessor> ghost_range() const;
 
+    /**
+     * Returns local indices of own cells that use only own dofs, also on the cells connected
+     * through neighbours of lower dimension. These cells can be processed
+     * while the ghost values are being updated.
+     */
+    inline const std::vector<unsigned int> &own_interior_cells() const {
+        return interior_cells_;
+    }
+
+    /// Returns local indices of own cells that use some ghost dofs, complement of @p own_interior_cells.
+    inline const std::vector<unsigned int> &own_interface_cells() const {
+        return interface_cells_;
+    }
+
     /// Return size of own range (number of own cells)
     inline unsigned int own_size() const {
         return el_ds_->lsize();
@@ -257,6 +270,18 @@ public:
     /// Get the map between local dof indices and the global ones.
     const std::vector<LongIdx> & get_local_to_global_map() const { return local_to_global_dof_idx_; }
 
+    /**
+     * Coordinates of support points of own dofs computed by MappingP1.
+     * Three values per dof ordered by local dof index, used by algebraic multigrid preconditioners.
+     */
+    std::vector<double> own_dof_coordinates() const;
+
+    /**
+     * Rigid body modes (three translations and three rotations) of a vector valued (displacement)
+     * finite element space, i.e. the near null space of the elasticity operator.
+     */
+    std::vector<VectorMPI> rigid_body_modes();
+
     /// Destructor.
     ~DOFHandlerMultiDim() override;
     
@@ -307,45 +332,68 @@ protected:
                      std::vector<short int> &edge_status);
     
     /**
-     * @brief Obtain dof numbers on ghost elements from other processor.
-     * @param proc  Neighbouring processor.
-     * @param dofs  Array where dofs are stored (output).
+     * @brief Get global dof numbers on own elements required by other processor.
+     * @param elems Global indices of required own elements.
+     * @param dofs  Global dofs on the elements, INVALID_DOF if not known yet (output).
      */
-    void receive_ghost_dofs(unsigned int proc,
-                            std::vector<LongIdx> &dofs);
+    void get_requested_dofs(const std::vector<LongIdx> &elems,
+                            std::vector<LongIdx> &dofs) const;
 
     /**
-     * @brief Send dof numbers to other processor.
+     * @brief Return number of dofs on ghost elements from processor @p proc.
      * @param proc  Neighbouring processor.
-     */    
-    void send_ghost_dofs(unsigned int proc);
+     */
+    unsigned int n_ghost_dofs(unsigned int proc) const;
     
     /** 
-     * @brief Update dofs on local elements from ghost element dofs.
+     * @brief Update dofs on ghost elements from processor @p proc.
      * 
      * @param proc            Neighbouring processor.
-     * @param update_cells    Vector of global indices of elements which need to be updated
-     *                        from ghost elements.
      * @param dofs            Vector of dof indices on ghost elements from processor @p proc.
+     * @param only_shared     If true, only known dofs on nodes and edges are stored
+     *                        (to update local elements), ghost elements are not updated.
      * @param node_dof_starts Vector of starting indices of nodal dofs.
      * @param node_dofs       Vector of nodal dof indices (output).
      * @param edge_dof_starts Vector of starting indices of edge dofs.
      * @param edge_dofs       Vector of edge dof indices (output).
      */
-    void update_local_dofs(unsigned int proc,
-                           const std::vector<bool> &update_cells,
+    void update_ghost_dofs(unsigned int proc,
                            const std::vector<LongIdx> &dofs,
+                           bool only_shared,
                            const std::vector<LongIdx> &node_dof_starts,
                            std::vector<LongIdx> &node_dofs,
                            const std::vector<LongIdx> &edge_dof_starts,
                            std::vector<LongIdx> &edge_dofs);
     
+    /** 
+     * @brief Update dofs on local elements from ghost element dofs.
+     * 
+     * @param update_cells    Vector of flags of local elements which need to be updated
+     *                        from ghost elements.
+     * @param node_dof_starts Vector of starting indices of nodal dofs.
+     * @param node_dofs       Vector of nodal dof indices.
+     * @param edge_dof_starts Vector of starting indices of edge dofs.
+     * @param edge_dofs       Vector of edge dof indices.
+     */
+    void update_own_dofs(const std::vector<bool> &update_cells,
+                         const std::vector<LongIdx> &node_dof_starts,
+                         const std::vector<LongIdx> &node_dofs,
+                         const std::vector<LongIdx> &edge_dof_starts,
+                         const std::vector<LongIdx> &edge_dofs);
+    
     /**
      * @brief Communicate local dof indices to all processors and create new sequential dof handler.
      *
      * Collective on all processors.
      */
     void create_sequential();
+
+    /// Split own cells into interior and interface cells.
+    void init_interface_cells();
+
+    /// Real coordinates of the support point of dof @p idof on the @p cell.
+    template<unsigned int dim>
+    arma::vec3 dof_support_point(const DHCellAccessor &cell, unsigned int idof) const;
     
     /**
      * @brief Returns the global indices of dofs associated to the @p cell.
@@ -430,14 +478,19 @@ protected:
      * @brief Maps local and ghost dof indices to global ones.
      * 
      * First lsize_ entries correspond to dofs owned by local processor,
-     * the remaining entries are ghost dofs sorted by neighbouring processor id.
+     * the remaining entries are ghost dofs: first node and edge dofs of ghost elements
+     * known after the first exchange round (they include all dofs shared with own
+     * elements, but possibly also other ones), then remaining dofs of ghost elements,
+     * both sorted by neighbouring processor id.
      */
     std::vector<LongIdx> local_to_global_dof_idx_;
     
     /**
-     * @brief Maps global element index into local/ghost index (obsolete).
+     * @brief Maps global element index into local/ghost index, -1 for other elements.
+     *
+     * Direct index of size of bulk elements of the mesh.
      */
-    std::unordered_map<LongIdx,LongIdx> global_to_local_el_idx_;
+    std::vector<LongIdx> global_to_local_el_idx_;
     
     /// Distribution of elements
     Distribution *el_ds_;
@@ -457,6 +510,12 @@ protected:
     /// Arrays of ghost cells for each neighbouring processor.
     map<unsigned int, vector<LongIdx> > ghost_proc_el;
 
+    /// Local indices of own cells using only own dofs.
+    std::vector<unsigned int> interior_cells_;
+
+    /// Local indices of own cells using some ghost dofs.
+    std::vector<unsigned int> interface_cells_;
+
 };
 
 
@@ -493,12 +552,6 @@ public:
     
 private:
 
-    /// Get global dof indices of ghost dofs for sub-handler.
-    void receive_sub_ghost_dofs(unsigned int proc, vector<LongIdx> &dofs);
-    
-    /// Send global indices of dofs that are ghost on other processors.
-    void send_sub_ghost_dofs(unsigned int proc, const map<LongIdx,LongIdx> &global_to_local_dof_idx);
-
     /// Parent dof handler.
     std::shared_ptr<DOFHandlerMultiDim> parent_;
     
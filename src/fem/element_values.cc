@@ -21,6 +21,7 @@
 #include "fem/mapping_p1.hh"
 #include "quadrature/quadrature.hh"
 #include "fem/element_values.hh"
+#include "mesh/mesh_geometry.hh"
 
 
 
@@ -270,6 +271,21 @@ template<unsigned int dim>
 void ElementValues<spacedim>::fill_data()
 {
     typename MappingP1<dim,spacedim>::ElementMap coords;
+    ElementAccessor<spacedim> elm = cell().is_valid() ? cell() : side().element();
+
+    // use precomputed geometry of the mesh if available
+    const MeshGeometry *geometry = elm.mesh()->geometry();
+    if (geometry != nullptr && !elm.is_boundary() && geometry->contains(elm.mesh_idx()))
+    {
+        fill_cached_data<dim>(*geometry, elm.mesh_idx());
+        if (cell().is_valid() && data.update_flags & update_quadrature_points)
+        {
+            coords = MappingP1<dim,spacedim>::element_map(elm);
+            for (unsigned int i=0; i<n_points_; i++)
+                data.points.set(i) = Armor::vec<spacedim>( coords*ref_data->bar_coords[i] );
+        }
+        return;
+    }
 
     if ((data.update_flags & update_jacobians) |
         (data.update_flags & update_volume_elements) |
@@ -278,10 +294,7 @@ void ElementValues<spacedim>::fill_data()
         (data.update_flags & update_normal_vectors) |
         (data.update_flags & update_quadrature_points))
     {
-        if (cell().is_valid())
-            coords = MappingP1<dim,spacedim>::element_map(cell());
-        else
-            coords = MappingP1<dim,spacedim>::element_map(side().element());
+        coords = MappingP1<dim,spacedim>::element_map(elm);
     }
 
     // calculation of Jacobian dependent data
@@ -341,19 +354,59 @@ void ElementValues<spacedim>::fill_data()
 }
 
 
+template<unsigned int spacedim>
+template<unsigned int dim>
+void ElementValues<spacedim>::fill_cached_data(const MeshGeometry &geometry, unsigned int elm_idx)
+{
+    if (data.update_flags & update_jacobians)
+    {
+        arma::mat::fixed<spacedim,dim> jac = geometry.jacobian<dim>(elm_idx);
+        for (unsigned int i=0; i<n_points_; i++)
+            data.jacobians.set(i) = Armor::mat<spacedim,dim>( jac );
+    }
+
+    if ((data.update_flags & update_volume_elements) |
+        (data.update_flags & update_JxW_values))
+    {
+        double det = geometry.determinant(elm_idx);
+        if (data.update_flags & update_volume_elements)
+            for (unsigned int i=0; i<n_points_; i++)
+                data.determinants[i] = det;
+        if (data.update_flags & update_JxW_values)
+            for (unsigned int i=0; i<n_points_; i++)
+                data.JxW_values[i] = det*ref_data->weights[i];
+    }
+
+    if (data.update_flags & update_inverse_jacobians)
+    {
+        arma::mat::fixed<dim,spacedim> ijac = geometry.inverse_jacobian<dim>(elm_idx);
+        for (unsigned int i=0; i<n_points_; i++)
+            data.inverse_jacobians.set(i) = Armor::mat<dim,spacedim>( ijac );
+    }
+}
+
+
 template<unsigned int spacedim>
 template<unsigned int dim>
 void ElementValues<spacedim>::fill_side_data()
 {
     const unsigned int side_idx = side().side_idx();
     const unsigned int perm_idx = side().element()->permutation_idx(side_idx);
+    const unsigned int elm_idx = side().element().mesh_idx();
+    const MeshGeometry *geometry = side().mesh()->geometry();
+    const bool cached = (geometry != nullptr && !side().element().is_boundary() && geometry->contains(elm_idx));
 
     // calculation of normal vectors to the side
     if (data.update_flags & update_normal_vectors)
     {
         arma::vec::fixed<spacedim> n_cell;
-        n_cell = trans(data.inverse_jacobians.template mat<dim,spacedim>(0))*RefElement<dim>::normal_vector(side_idx);
-        n_cell = n_cell/norm(n_cell,2);
+        if (cached)
+            n_cell = geometry->normal_vector(elm_idx, side_idx);
+        else
+        {
+            n_cell = trans(data.inverse_jacobians.template mat<dim,spacedim>(0))*RefElement<dim>::normal_vector(side_idx);
+            n_cell = n_cell/norm(n_cell,2);
+        }
         for (unsigned int i=0; i<n_points_; i++)
             data.normal_vectors.set(i) = Armor::vec<spacedim>( n_cell );
     }
@@ -370,7 +423,11 @@ void ElementValues<spacedim>::fill_side_data()
     if (data.update_flags & update_side_JxW_values)
     {
         double side_det;
-        if (dim <= 1)
+        if (cached)
+        {
+            side_det = geometry->side_determinant(elm_idx, side_idx);
+        }
+        else if (dim <= 1)
         {
             side_det = 1;
         }
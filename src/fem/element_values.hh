@@ -32,6 +32,7 @@
 #include "fem/dh_cell_accessor.hh"            // for DHCellAccessor, DHCellSide
 
 class Quadrature;
+class MeshGeometry;
 
 
 
@@ -279,6 +280,10 @@ protected:
     template<unsigned int dim>
     void fill_side_data();
 
+    /// Copy Jacobian dependent data of element @p elm_idx from the precomputed mesh geometry.
+    template<unsigned int dim>
+    void fill_cached_data(const MeshGeometry &geometry, unsigned int elm_idx);
+
     
 
     /// Dimension of space of reference cell.
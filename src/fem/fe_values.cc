@@ -59,6 +59,23 @@ FEValues<spacedim>::FEInternalData::FEInternalData(const FEInternalData &fe_syst
             ref_shape_values[ip][id] = fe_system_data.ref_shape_values[ip][dof_indices[id]].subvec(first_component_idx, first_component_idx+ncomps-1);
             ref_shape_grads[ip][id] = fe_system_data.ref_shape_grads[ip][dof_indices[id]].cols(first_component_idx, first_component_idx+ncomps-1);
         }
+    init_grads_block();
+}
+
+
+template<unsigned int spacedim>
+void FEValues<spacedim>::FEInternalData::init_grads_block()
+{
+    ref_shape_grads_block.resize(n_points);
+    if (n_points == 0 || n_dofs == 0) return;
+
+    unsigned int n_comp = ref_shape_grads[0][0].n_cols;
+    for (unsigned int ip=0; ip<n_points; ip++)
+    {
+        ref_shape_grads_block[ip].set_size(ref_shape_grads[ip][0].n_rows, n_dofs*n_comp);
+        for (unsigned int id=0; id<n_dofs; id++)
+            ref_shape_grads_block[ip].cols(id*n_comp, (id+1)*n_comp-1) = ref_shape_grads[ip][id];
+    }
 }
 
 
@@ -120,7 +137,7 @@ void FEValues<spacedim>::ViewsCache::initialize(const FEValues<spacedim> &fv, co
 
 template<unsigned int spacedim>
 FEValues<spacedim>::FEValues()
-: dim_(-1), n_points_(0), n_dofs_(0)
+: dim_(-1), n_points_(0), n_dofs_(0), values_source_(nullptr)
 {
 }
 
@@ -216,11 +233,12 @@ void FEValues<spacedim>::allocate(
     // add flags required by the finite element or mapping
     update_flags = _flags | _fe.update_each(_flags);
     update_flags |= MappingP1<DIM,spacedim>::update_each(update_flags);
+    values_source_ = nullptr;
     if (update_flags & update_values)
-        shape_values.resize(n_points_, vector<double>(n_dofs_*n_components_));
+        shape_values.resize(n_points_*n_dofs_*n_components_);
 
     if (update_flags & update_gradients)
-        shape_gradients.resize(n_points_, vector<arma::vec::fixed<spacedim> >(n_dofs_*n_components_));
+        shape_gradients.resize(n_points_*n_dofs_*n_components_*spacedim);
     
     views_cache_.initialize(*this, _fe);
 }
@@ -259,17 +277,35 @@ std::shared_ptr<typename FEValues<spacedim>::FEInternalData> FEValues<spacedim>:
             data->ref_shape_grads[i][j] = grad;
         }
     }
+    data->init_grads_block();
+    init_sub_fe_data(*data);
     
     return data;
 }
 
 
+template<unsigned int spacedim>
+void FEValues<spacedim>::init_sub_fe_data(FEInternalData &data)
+{
+    if (fe_type_ != FEMixedSystem) return;
+
+    // sub-element data of FESystem are created once here, not in every reinit
+    unsigned int comp_offset = 0;
+    for (unsigned int f=0; f<fe_sys_dofs_.size(); f++)
+    {
+        data.sub_fe_data.push_back(std::make_shared<FEInternalData>(data, fe_sys_dofs_[f], comp_offset, fe_sys_n_components_[f]));
+        fe_values_vec[f].init_sub_fe_data(*data.sub_fe_data[f]);
+        comp_offset += fe_sys_n_components_[f];
+    }
+}
+
+
 template<unsigned int spacedim>
 double FEValues<spacedim>::shape_value(const unsigned int function_no, const unsigned int point_no)
 {
   ASSERT_LT_DBG(function_no, n_dofs_);
   ASSERT_LT_DBG(point_no, n_points_);
-  return shape_values[point_no][function_no];
+  return shape_values[point_no*n_dofs_*n_components_+function_no];
 }
 
 
@@ -278,7 +314,7 @@ arma::vec::fixed<spacedim> FEValues<spacedim>::shape_grad(const unsigned int fun
 {
   ASSERT_LT_DBG(function_no, n_dofs_);
   ASSERT_LT_DBG(point_no, n_points_);
-  return shape_gradients[point_no][function_no];
+  return arma::vec::fixed<spacedim>(&shape_gradients[spacedim*(point_no*n_dofs_*n_components_+function_no)]);
 }
 
 
@@ -290,7 +326,7 @@ double FEValues<spacedim>::shape_value_component(const unsigned int function_no,
   ASSERT_LT_DBG(function_no, n_dofs_);
   ASSERT_LT_DBG(point_no, n_points_);
   ASSERT_LT_DBG(comp, n_components_);
-  return shape_values[point_no][function_no*n_components_+comp];
+  return shape_values[shape_idx(function_no, point_no, comp)];
 }
 
 
@@ -302,7 +338,37 @@ arma::vec::fixed<spacedim> FEValues<spacedim>::shape_grad_component(const unsign
   ASSERT_LT_DBG(function_no, n_dofs_);
   ASSERT_LT_DBG(point_no, n_points_);
   ASSERT_LT_DBG(comp, n_components_);
-  return shape_gradients[point_no][function_no*n_components_+comp];
+  return arma::vec::fixed<spacedim>(&shape_gradients[spacedim*shape_idx(function_no, point_no, comp)]);
+}
+
+
+template<unsigned int spacedim>
+void FEValues<spacedim>::fill_ref_values(const FEInternalData &fe_data)
+{
+    // values do not depend on the element, copy them only if the reference data changed
+    if (values_source_ == &fe_data) return;
+
+    for (unsigned int i = 0; i < fe_data.n_points; i++)
+        for (unsigned int j = 0; j < fe_data.n_dofs; j++)
+            for (unsigned int c = 0; c < n_components_; c++)
+                shape_values[shape_idx(j,i,c)] = fe_data.ref_shape_values[i][j][c];
+    values_source_ = &fe_data;
+}
+
+
+template<unsigned int spacedim>
+void FEValues<spacedim>::fill_affine_gradients(const ElementValues<spacedim> &elm_values,
+                                                   const FEInternalData &fe_data)
+{
+    // the mapping is affine, so one inverse Jacobian transforms all points
+    arma::mat ijac_t = trans(elm_values.inverse_jacobian(0));
+    unsigned int n_cols = n_dofs_*n_components_;
+    if (n_cols == 0) return;
+    for (unsigned int i = 0; i < fe_data.n_points; i++)
+    {
+        arma::mat grads(&shape_gradients[spacedim*n_cols*i], spacedim, n_cols, false, true);
+        grads = ijac_t * fe_data.ref_shape_grads_block[i];
+    }
 }
 
 
@@ -313,15 +379,11 @@ void FEValues<spacedim>::fill_scalar_data(const ElementValues<spacedim> &elm_val
     
     // shape values
     if (update_flags & update_values)
-        for (unsigned int i = 0; i < fe_data.n_points; i++)
-            for (unsigned int j = 0; j < fe_data.n_dofs; j++)
-                shape_values[i][j] = fe_data.ref_shape_values[i][j][0];
+        fill_ref_values(fe_data);
 
     // shape gradients
     if (update_flags & update_gradients)
-        for (unsigned int i = 0; i < fe_data.n_points; i++)
-            for (unsigned int j = 0; j < fe_data.n_dofs; j++)
-                shape_gradients[i][j] = trans(elm_values.inverse_jacobian(i)) * fe_data.ref_shape_grads[i][j];
+        fill_affine_gradients(elm_values, fe_data);
 }
 
 
@@ -333,27 +395,11 @@ void FEValues<spacedim>::fill_vec_data(const ElementValues<spacedim> &elm_values
     
     // shape values
     if (update_flags & update_values)
-    {
-        for (unsigned int i = 0; i < fe_data.n_points; i++)
-            for (unsigned int j = 0; j < fe_data.n_dofs; j++)
-            {
-                arma::vec fv_vec = fe_data.ref_shape_values[i][j];
-                for (unsigned int c=0; c<spacedim; c++)
-                    shape_values[i][j*spacedim+c] = fv_vec[c];
-            }
-    }
+        fill_ref_values(fe_data);
 
     // shape gradients
     if (update_flags & update_gradients)
-    {
-        for (unsigned int i = 0; i < fe_data.n_points; i++)
-            for (unsigned int j = 0; j < fe_data.n_dofs; j++)
-            {
-                arma::mat grads = trans(elm_values.inverse_jacobian(i)) * fe_data.ref_shape_grads[i][j];
-                for (unsigned int c=0; c<spacedim; c++)
-                    shape_gradients[i][j*spacedim+c] = grads.col(c);
-            }
-    }
+        fill_affine_gradients(elm_values, fe_data);
 }
 
 
@@ -371,7 +417,7 @@ void FEValues<spacedim>::fill_vec_contravariant_data(const ElementValues<spacedi
             {
                 arma::vec fv_vec = elm_values.jacobian(i) * fe_data.ref_shape_values[i][j];
                 for (unsigned int c=0; c<spacedim; c++)
-                    shape_values[i][j*spacedim+c] = fv_vec[c];
+                    shape_values[shape_idx(j,i,c)] = fv_vec[c];
             }
     }
 
@@ -381,9 +427,8 @@ void FEValues<spacedim>::fill_vec_contravariant_data(const ElementValues<spacedi
         for (unsigned int i = 0; i < fe_data.n_points; i++)
             for (unsigned int j = 0; j < fe_data.n_dofs; j++)
             {
-                arma::mat grads = trans(elm_values.inverse_jacobian(i)) * fe_data.ref_shape_grads[i][j] * trans(elm_values.jacobian(i));
-                for (unsigned int c=0; c<spacedim; c++)
-                    shape_gradients[i][j*spacedim+c] = grads.col(c);
+                arma::mat grads(&shape_gradients[spacedim*shape_idx(j,i,0)], spacedim, spacedim, false, true);
+                grads = trans(elm_values.inverse_jacobian(i)) * fe_data.ref_shape_grads[i][j] * trans(elm_values.jacobian(i));
             }
     }
 }
@@ -403,7 +448,7 @@ void FEValues<spacedim>::fill_vec_piola_data(const ElementValues<spacedim> &elm_
             {
                 arma::vec fv_vec = elm_values.jacobian(i)*fe_data.ref_shape_values[i][j]/elm_values.determinant(i);
                 for (unsigned int c=0; c<spacedim; c++)
-                    shape_values[i][j*spacedim+c] = fv_vec(c);
+                    shape_values[shape_idx(j,i,c)] = fv_vec(c);
             }
     }
 
@@ -413,10 +458,9 @@ void FEValues<spacedim>::fill_vec_piola_data(const ElementValues<spacedim> &elm_
         for (unsigned int i = 0; i < fe_data.n_points; i++)
             for (unsigned int j = 0; j < fe_data.n_dofs; j++)
             {
-                arma::mat grads = trans(elm_values.inverse_jacobian(i)) * fe_data.ref_shape_grads[i][j] * trans(elm_values.jacobian(i))
+                arma::mat grads(&shape_gradients[spacedim*shape_idx(j,i,0)], spacedim, spacedim, false, true);
+                grads = trans(elm_values.inverse_jacobian(i)) * fe_data.ref_shape_grads[i][j] * trans(elm_values.jacobian(i))
                         / elm_values.determinant(i);
-                for (unsigned int c=0; c<spacedim; c++)
-                    shape_gradients[i][j*spacedim+c] = grads.col(c);
             }   
     }
 }
@@ -430,27 +474,11 @@ void FEValues<spacedim>::fill_tensor_data(const ElementValues<spacedim> &elm_val
     
     // shape values
     if (update_flags & update_values)
-    {
-        for (unsigned int i = 0; i < fe_data.n_points; i++)
-            for (unsigned int j = 0; j < fe_data.n_dofs; j++)
-            {
-                arma::vec fv_vec = fe_data.ref_shape_values[i][j];
-                for (unsigned int c=0; c<spacedim*spacedim; c++)
-                    shape_values[i][j*spacedim*spacedim+c] = fv_vec[c];
-            }
-    }
+        fill_ref_values(fe_data);
 
     // shape gradients
     if (update_flags & update_gradients)
-    {
-        for (unsigned int i = 0; i < fe_data.n_points; i++)
-            for (unsigned int j = 0; j < fe_data.n_dofs; j++)
-            {
-                arma::mat grads = trans(elm_values.inverse_jacobian(i)) * fe_data.ref_shape_grads[i][j];
-                for (unsigned int c=0; c<spacedim*spacedim; c++)
-                    shape_gradients[i][j*spacedim*spacedim+c] = grads.col(c);
-            }
-    }
+        fill_affine_gradients(elm_values, fe_data);
 }
 
 
@@ -460,15 +488,9 @@ void FEValues<spacedim>::fill_system_data(const ElementValues<spacedim> &elm_val
     ASSERT_DBG(fe_type_ == FEMixedSystem);
     
     // for mixed system we first fill data in sub-elements
-    unsigned int comp_offset = 0;
+    ASSERT_EQ_DBG(fe_data.sub_fe_data.size(), fe_sys_dofs_.size());
     for (unsigned int f=0; f<fe_sys_dofs_.size(); f++)
-    {
-        // fill fe_values for base FE
-        FEInternalData vec_fe_data(fe_data, fe_sys_dofs_[f], comp_offset, fe_sys_n_components_[f]);
-        fe_values_vec[f].fill_data(elm_values, vec_fe_data);
-        
-        comp_offset += fe_sys_n_components_[f];
-    }
+        fe_values_vec[f].fill_data(elm_values, *fe_data.sub_fe_data[f]);
     
     // shape values
     if (update_flags & update_values)
@@ -482,7 +504,8 @@ void FEValues<spacedim>::fill_system_data(const ElementValues<spacedim> &elm_val
             for (unsigned int i=0; i<fe_data.n_points; i++)
                 for (unsigned int n=0; n<fe_sys_dofs_[f].size(); n++)
                     for (unsigned int c=0; c<fe_sys_n_space_components_[f]; c++)
-                        shape_values[i][shape_offset+n_components_*n+comp_offset+c] = fe_values_vec[f].shape_values[i][n*fe_sys_n_space_components_[f]+c];
+                        shape_values[i*n_dofs_*n_components_+shape_offset+n_components_*n+comp_offset+c] =
+                                fe_values_vec[f].shape_values[fe_values_vec[f].shape_idx(n,i,c)];
             
             comp_offset += fe_sys_n_space_components_[f];
             shape_offset += fe_sys_dofs_[f].size()*n_components_;
@@ -501,7 +524,12 @@ void FEValues<spacedim>::fill_system_data(const ElementValues<spacedim> &elm_val
             for (unsigned int i=0; i<fe_data.n_points; i++)
                 for (unsigned int n=0; n<fe_sys_dofs_[f].size(); n++)
                     for (unsigned int c=0; c<fe_sys_n_space_components_[f]; c++)
-                        shape_gradients[i][shape_offset+n_components_*n+comp_offset+c] = fe_values_vec[f].shape_gradients[i][n*fe_sys_n_space_components_[f]+c];
+                    {
+                        unsigned int idx = i*n_dofs_*n_components_+shape_offset+n_components_*n+comp_offset+c;
+                        unsigned int sub_idx = fe_values_vec[f].shape_idx(n,i,c);
+                        for (unsigned int k=0; k<spacedim; k++)
+                            shape_gradients[spacedim*idx+k] = fe_values_vec[f].shape_gradients[spacedim*sub_idx+k];
+                    }
             
             comp_offset += fe_sys_n_space_components_[f];
             shape_offset += fe_sys_dofs_[f].size()*n_components_;
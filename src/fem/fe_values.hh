@@ -318,6 +318,23 @@ protected:
          *             x ((dim_ of. ref. cell)x(no. of components in ref. cell))
          */
         std::vector<std::vector<arma::mat> > ref_shape_grads;
+
+        /**
+         * @brief Gradients of all basis functions at each quadrature point gathered in one matrix.
+         *
+         * Dimensions:   (no. of quadrature points)
+         *             x (dim_ of. ref. cell)x(no. of dofs * no. of components in ref. cell)
+         *
+         * Column j*n_components+c holds the gradient of component c of the j-th basis function,
+         * so that the gradients on the actual cell are obtained by a single matrix product.
+         */
+        std::vector<arma::mat> ref_shape_grads_block;
+
+        /// Precomputed data of sub-elements of FESystem (empty for other FE types).
+        std::vector<std::shared_ptr<FEInternalData> > sub_fe_data;
+
+        /// Gather @p ref_shape_grads into @p ref_shape_grads_block.
+        void init_grads_block();
         
         /// Number of quadrature points.
         unsigned int n_points;
@@ -333,6 +350,9 @@ protected:
     /// Precompute finite element data on reference element.
     template<unsigned int DIM>
     std::shared_ptr<FEInternalData> init_fe_data(const FiniteElement<DIM> &fe, const Quadrature &q);
+
+    /// Create precomputed data of FESystem sub-elements (recursively) from the data of the system.
+    void init_sub_fe_data(FEInternalData &data);
     
     /**
      * @brief Computes the shape function values and gradients on the actual cell
@@ -342,6 +362,12 @@ protected:
      */
     void fill_data(const ElementValues<spacedim> &elm_values, const FEInternalData &fe_data);
     
+    /// Copy element independent shape values of scalar, vector and tensor FE (if changed).
+    void fill_ref_values(const FEInternalData &fe_data);
+
+    /// Compute gradients of scalar, vector and tensor FE by one affine transformation per point.
+    void fill_affine_gradients(const ElementValues<spacedim> &elm_values, const FEInternalData &fe_data);
+
     /// Compute shape functions and gradients on the actual cell for scalar FE.
     void fill_scalar_data(const ElementValues<spacedim> &elm_values, const FEInternalData &fe_data);
     
@@ -382,12 +408,28 @@ protected:
     /// Numbers of components of FESystem sub-elements in real space.
     std::vector<unsigned int> fe_sys_n_space_components_;
     
-    /// Shape functions evaluated at the quadrature points.
-    std::vector<std::vector<double> > shape_values;
+    /// Return index of component @p comp of shape function @p function_no at @p point_no in @p shape_values.
+    inline unsigned int shape_idx(unsigned int function_no, unsigned int point_no, unsigned int comp) const
+    { return (point_no*n_dofs_ + function_no)*n_components_ + comp; }
+
+    /**
+     * @brief Shape functions evaluated at the quadrature points.
+     *
+     * Contiguous array of size (no. of points) x (no. of dofs) x (no. of components),
+     * addressed by shape_idx().
+     */
+    std::vector<double> shape_values;
+
+    /**
+     * @brief Gradients of shape functions evaluated at the quadrature points.
+     *
+     * Contiguous array of size (no. of points) x (no. of dofs) x (no. of components) x spacedim,
+     * the gradient of a component starts at position spacedim*shape_idx().
+     */
+    std::vector<double> shape_gradients;
 
-    /// Gradients of shape functions evaluated at the quadrature points.
-    /// Each row of the matrix contains the gradient of one shape function.
-    std::vector<std::vector<arma::vec::fixed<spacedim> > > shape_gradients;
+    /// Reference data whose element independent values are currently stored in @p shape_values.
+    const FEInternalData *values_source_;
 
     /// Flags that indicate which finite element quantities are to be computed.
     UpdateFlags update_flags;
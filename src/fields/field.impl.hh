@@ -113,6 +113,7 @@ Field<spacedim,Value> &Field<spacedim,Value>::operator=(const Field<spacedim,Val
 	shared_ = other.shared_;
     shared_->is_fully_initialized_ = false;
 	set_time_result_ = other.set_time_result_;
+	changed_regions_ = other.changed_regions_;
 	last_time_ = other.last_time_;
 	last_limit_side_ = other.last_limit_side_;
 	is_jump_time_ = other.is_jump_time_;
@@ -287,6 +288,7 @@ bool Field<spacedim, Value>::set_time(const TimeStep &time_step, LimitSide limit
     }
         
     set_time_result_ = TimeStatus::constant;
+    changed_regions_.assign(mesh()->region_db().size(), false);
     
     // read all descriptors satisfying time.ge(input_time)
     update_history(time_step);
@@ -331,9 +333,13 @@ bool Field<spacedim, Value>::set_time(const TimeStep &time_step, LimitSide limit
         if (new_ptr != region_fields_[reg.idx()]) {
             region_fields_[reg.idx()]=new_ptr;
             set_time_result_ = TimeStatus::changed;
+            changed_regions_[reg.idx()] = true;
         }
         // let FieldBase implementation set the time
-        if ( new_ptr->set_time(time_step) )  set_time_result_ = TimeStatus::changed;
+        if ( new_ptr->set_time(time_step) ) {
+            set_time_result_ = TimeStatus::changed;
+            changed_regions_[reg.idx()] = true;
+        }
 
     }
 
@@ -736,10 +742,10 @@ void Field<spacedim, Value>::cache_allocate(std::shared_ptr<EvalPoints> eval_poi
 
 template<int spacedim, class Value>
 void Field<spacedim, Value>::cache_update(ElementCacheMap &cache_map) {
-    auto update_cache_data = cache_map.update_cache_data();
+    const auto &update_cache_data = cache_map.update_cache_data();
 
     // Call cache_update of FieldAlgoBase descendants
-    std::unordered_map<unsigned int, unsigned int>::iterator reg_elm_it;
+    ElementCacheMap::UpdateCacheHelper::IndexMap::const_iterator reg_elm_it;
     for (reg_elm_it=update_cache_data.region_cache_indices_range_.begin(); reg_elm_it!=update_cache_data.region_cache_indices_range_.end(); ++reg_elm_it) {
         region_fields_[reg_elm_it->first]->cache_update(value_cache_, cache_map, reg_elm_it->first);
     }
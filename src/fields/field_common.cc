@@ -47,6 +47,7 @@ FieldCommon::FieldCommon(const FieldCommon & other)
 : name_(other.name_),
   shared_(other.shared_),
   set_time_result_(other.set_time_result_),
+  changed_regions_(other.changed_regions_),
   last_time_(other.last_time_),
   last_limit_side_(other.last_limit_side_),
   is_jump_time_(other.is_jump_time_),
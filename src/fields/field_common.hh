@@ -344,6 +344,18 @@ public:
         return ( (set_time_result_ == TimeStatus::changed) );
     }
 
+    /**
+     * Returns true if the field changed on the given region during the last set_time method.
+     * Allows to recompute only the data of changed regions (e.g. only boundary conditions).
+     * If the field was marked as changed manually (@p set_time_result_changed), returns true for all regions.
+     */
+    bool changed(Region reg) const
+    {
+    	ASSERT( set_time_result_ != TimeStatus::unknown ).error("Invalid time status.");
+        if (set_time_result_ != TimeStatus::changed) return false;
+        return ( reg.idx() >= changed_regions_.size() ) || changed_regions_[reg.idx()];
+    }
+
     /**
      * Common part of the field descriptor. To get finished record
      * one has to add keys for individual fields. This is done automatically
@@ -601,6 +613,12 @@ protected:
      */
     TimeStatus set_time_result_;
 
+    /**
+     * Flags of regions (indexed by region idx) where the field changed during the last set_time method.
+     * Empty vector means that the change is not specified per regions.
+     */
+    std::vector<bool> changed_regions_;
+
     /**
      * Last set time. Can be different for different field copies.
      * Store also time limit, since the field may be discontinuous.
@@ -660,7 +678,10 @@ public:
     
     /// Manually mark flag that the field has been changed.
     void set_time_result_changed()
-    { set_time_result_ = TimeStatus::changed; }
+    {
+        set_time_result_ = TimeStatus::changed;
+        changed_regions_.clear();
+    }
 };
 
 
@@ -245,7 +245,7 @@ void FieldFE<spacedim, Value>::cache_update(FieldValueCache<typename Value::elem
         fe_values_[3].initialize(quads[3], *fe_[3_d], update_values);
     }
 
-    auto update_cache_data = cache_map.update_cache_data();
+    const auto &update_cache_data = cache_map.update_cache_data();
     unsigned int region_in_cache = update_cache_data.region_cache_indices_range_.find(region_idx)->second;
 
     for (unsigned int i_elm=update_cache_data.region_element_cache_range_[region_in_cache];
@@ -311,6 +311,12 @@ void FieldFE<spacedim, Value>::set_mesh(const Mesh *mesh, bool boundary_domain)
     if ( flags_.match(FieldFlag::equation_input) && flags_.match(FieldFlag::declare_input) ) {
         ASSERT(field_name_ != "").error("Uninitialized FieldFE, did you call init_from_input()?\n");
         this->boundary_domain_ = boundary_domain;
+        if (this->interpolation_ == DataInterpolation::identic_msh && mesh->elements_reordered()) {
+            // data are read in order of IDs, which differs from order of reordered elements
+            this->interpolation_ = DataInterpolation::equivalent_msh;
+            WarningOut().fmt("Interpolation 'identic_mesh' of FieldFE '{}' can't be used on mesh with reordered elements.\nIt will be changed to 'equivalent_mesh'.\n",
+                    field_name_);
+        }
         if (this->interpolation_ == DataInterpolation::identic_msh) {
             ReaderCache::get_element_ids(reader_file_, *mesh);
         } else {
@@ -70,6 +70,8 @@ template <int spacedim, class Value>
 FieldFormula<spacedim, Value>::FieldFormula( unsigned int n_comp)
 : FieldAlgorithmBase<spacedim, Value>(n_comp),
   formula_matrix_(this->value_.n_rows(), this->value_.n_cols()),
+  has_depth_var_(false),
+  is_time_dependent_(false),
   first_time_set_(true)
 {
 	this->is_constant_in_space_ = false;
@@ -93,17 +95,53 @@ void FieldFormula<spacedim, Value>::init_from_input(const Input::Record &rec, co
 
 template <int spacedim, class Value>
 bool FieldFormula<spacedim, Value>::set_time(const TimeStep &time) {
-
+    // time is used also in error messages (e.g. SurfaceDepth), so it is kept up to date
+    this->time_=time;
+    if (first_time_set_) this->analyze_formulas();
+    else if (!is_time_dependent_) return false; // parsers are up to date
 
     bool any_parser_changed = false;
+    std::string value_input_address = in_rec_.address_string();
+
+	// update parsers
+	for(unsigned int row=0; row < this->value_.n_rows(); row++)
+		for(unsigned int col=0; col < this->value_.n_cols(); col++) {
+            // TODO:
+            // - possibly add user defined constants and units here ...
+            bool time_dependent = time_dependent_[row*this->value_.n_cols()+col];
+            if (time_dependent || first_time_set_ ) {
+                // Seems that we can not just add 't' constant to tmp_parser, since it was already Parsed.
+                if (time_dependent) parser_matrix_[row][col].AddConstant("t", time.end());
+                parser_matrix_[row][col].Parse(formula_matrix_.at(row,col), vars_);
+
+                if ( parser_matrix_[row][col].GetParseErrorType() != FunctionParser::FP_NO_ERROR ) {
+                    xprintf(UsrErr, "ParserError: %s\n in the FieldFormula[%d][%d] == '%s'\n at the input address:\n %s \n",
+                        parser_matrix_[row][col].ErrorMsg(),
+                        row,col,formula_matrix_.at(row,col).c_str(),
+                        value_input_address.c_str());
+                }
+
+                parser_matrix_[row][col].Optimize();
+                any_parser_changed = true;
+            }
+
+
+        }
+
+    first_time_set_ = false;
+    return any_parser_changed;
+}
+
+
+template <int spacedim, class Value>
+void FieldFormula<spacedim, Value>::analyze_formulas() {
     std::string value_input_address = in_rec_.address_string();
     has_depth_var_ = false;
+    is_time_dependent_ = false;
     this->is_constant_in_space_ = true; // set flag to true, then if found 'x', 'y', 'z' or 'd' reset to false
 
-
-    std::string vars = string("x,y,z").substr(0, 2*spacedim-1);
-    std::vector<bool> time_dependent(this->value_.n_rows() * this->value_.n_cols(), false);
-    // update parsers
+    vars_ = string("x,y,z").substr(0, 2*spacedim-1);
+    time_dependent_.assign(this->value_.n_rows() * this->value_.n_cols(), false);
     for(unsigned int row=0; row < this->value_.n_rows(); row++)
         for(unsigned int col=0; col < this->value_.n_cols(); col++) {
             // get all variable names from the formula
@@ -123,7 +161,10 @@ bool FieldFormula<spacedim, Value>::set_time(const TimeStep &time) {
 #pragma GCC diagnostic pop
 
             for(std::string &var_name : var_list ) {
-                if (var_name == std::string("t") ) time_dependent[row*this->value_.n_rows()+col]=true;
+                if (var_name == std::string("t") ) {
+                    time_dependent_[row*this->value_.n_cols()+col]=true;
+                    is_time_dependent_ = true;
+                }
                 else if (var_name == std::string("d") ) {
                 	this->is_constant_in_space_ = false;
                 	if (surface_depth_)
@@ -141,44 +182,12 @@ bool FieldFormula<spacedim, Value>::set_time(const TimeStep &time) {
                             var_name, row, col, formula_matrix_.at(row,col), value_input_address );
             }
 
-            // Seems that we can not just add 't' constant to tmp_parser, since it was already Parsed.
             parser_matrix_[row][col].AddConstant("Pi", 3.14159265358979323846);
             parser_matrix_[row][col].AddConstant("E", 2.71828182845904523536);
-            if (time_dependent[row*this->value_.n_rows()+col]) {
-                parser_matrix_[row][col].AddConstant("t", time.end());
-            }
         }
 
     if (has_depth_var_)
-        vars += string(",d");
-
-	// update parsers
-	for(unsigned int row=0; row < this->value_.n_rows(); row++)
-		for(unsigned int col=0; col < this->value_.n_cols(); col++) {
-            // TODO:
-            // - possibly add user defined constants and units here ...
-            // - optimization; possibly parse only if time_dependent  || formula_matrix[][] has changed ...
-            //parser_matrix_[row][col] = tmp_parser;
-            if (time_dependent[row*this->value_.n_rows()+col] || first_time_set_ ) {
-                parser_matrix_[row][col].Parse(formula_matrix_.at(row,col), vars);
-
-                if ( parser_matrix_[row][col].GetParseErrorType() != FunctionParser::FP_NO_ERROR ) {
-                    xprintf(UsrErr, "ParserError: %s\n in the FieldFormula[%d][%d] == '%s'\n at the input address:\n %s \n",
-                        parser_matrix_[row][col].ErrorMsg(),
-                        row,col,formula_matrix_.at(row,col).c_str(),
-                        value_input_address.c_str());
-                }
-
-                parser_matrix_[row][col].Optimize();
-                any_parser_changed = true;
-            }
-
-
-        }
-
-    first_time_set_ = false;
-    this->time_=time;
-    return any_parser_changed;
+        vars_ += string(",d");
 }
 
 
@@ -199,10 +208,11 @@ template <int spacedim, class Value>
 typename Value::return_type const & FieldFormula<spacedim, Value>::value(const Point &p, FMT_UNUSED  const ElementAccessor<spacedim> &elm)
 {
 
-    auto p_depth = this->eval_depth_var(p);
+    double p_depth[spacedim+1];
+    this->eval_depth_var(p, p_depth);
     for(unsigned int row=0; row < this->value_.n_rows(); row++)
         for(unsigned int col=0; col < this->value_.n_cols(); col++) {
-            this->value_(row,col) = this->unit_conversion_coefficient_ * parser_matrix_[row][col].Eval(p_depth.memptr());
+            this->value_(row,col) = this->unit_conversion_coefficient_ * parser_matrix_[row][col].Eval(p_depth);
         }
     return this->r_value_;
 }
@@ -217,37 +227,40 @@ void FieldFormula<spacedim, Value>::value_list (const Armor::array &point_list,
 {
 	ASSERT_EQ( point_list.size(), value_list.size() );
     ASSERT_DBG( point_list.n_rows() == spacedim && point_list.n_cols() == 1).error("Invalid point size.\n");
-    for(unsigned int i=0; i< point_list.size(); i++) {
+    if (point_list.size() == 0) return;
+
+    // Formula without spatial variables is evaluated only once.
+    unsigned int n_eval_points = this->is_constant_in_space_ ? 1 : point_list.size();
+    double p_depth[spacedim+1];
+    for(unsigned int i=0; i< n_eval_points; i++) {
         Value envelope(value_list[i]);
         ASSERT_EQ( envelope.n_rows(), this->value_.n_rows() )(i)(envelope.n_rows())(this->value_.n_rows())
         		.error("value_list['i'] has wrong number of rows\n");
-        auto p_depth = this->eval_depth_var(point_list.vec<spacedim>(i));
+        this->eval_depth_var(point_list.vec<spacedim>(i), p_depth);
 
         for(unsigned int row=0; row < this->value_.n_rows(); row++)
             for(unsigned int col=0; col < this->value_.n_cols(); col++) {
-                envelope(row,col) = this->unit_conversion_coefficient_ * parser_matrix_[row][col].Eval(p_depth.memptr());
+                envelope(row,col) = this->unit_conversion_coefficient_ * parser_matrix_[row][col].Eval(p_depth);
             }
     }
+    for(unsigned int i=n_eval_points; i< point_list.size(); i++)
+        value_list[i] = value_list[0];
 }
 
 
 template <int spacedim, class Value>
-inline arma::vec FieldFormula<spacedim, Value>::eval_depth_var(const Point &p)
+inline void FieldFormula<spacedim, Value>::eval_depth_var(const Point &p, double *p_depth)
 {
+	for (unsigned int i=0; i<spacedim; ++i) p_depth[i] = p(i);
 	if (surface_depth_ && has_depth_var_) {
 		// add value of depth
-		arma::vec p_depth(spacedim+1);
-		p_depth.subvec(0,spacedim-1) = p;
 		try {
-			p_depth(spacedim) = surface_depth_->compute_distance(p);
+			p_depth[spacedim] = surface_depth_->compute_distance(p);
 		} catch (SurfaceDepth::ExcTooLargeSnapDistance &e) {
 			e << SurfaceDepth::EI_FieldTime(this->time_.end());
 			e << in_rec_.ei_address();
 			throw;
 		}
-		return p_depth;
-	} else {
-		return p;
 	}
 }
 
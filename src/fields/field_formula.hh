@@ -95,9 +95,18 @@ private:
     /**
      * Evaluate depth variable if it is contained in formula.
      *
-     * Return arma vec of point coordinates extended by depth value (or zero if depth is not contained.
+     * Fill given buffer (of size spacedim+1) by point coordinates extended by depth value.
+     * Depth value is set only if depth variable is contained in formula.
      */
-    inline arma::vec eval_depth_var(const Point &p);
+    inline void eval_depth_var(const Point &p, double *p_depth);
+
+    /**
+     * Deduce variables of all formulas, set constants of parsers and flags
+     * @p is_constant_in_space_, @p has_depth_var_ and @p time_dependent_.
+     *
+     * Called only during the first call of set_time method, formulas don't change later.
+     */
+    void analyze_formulas();
 
     // StringValue::return_type == StringTensor, which behaves like arma::mat<string>
     StringTensor formula_matrix_;
@@ -114,6 +123,15 @@ private:
     /// Flag indicates if depth variable 'd' is used in formula
     bool has_depth_var_;
 
+    /// Flags indicate time dependent formulas (variable 't' is used), stored by rows.
+    std::vector<bool> time_dependent_;
+
+    /// Flag indicates if any of formulas is time dependent.
+    bool is_time_dependent_;
+
+    /// Variables of parsers, i.e. coordinates possibly extended by depth variable.
+    std::string vars_;
+
     /// Flag indicates first call of set_time method, when FunctionParsers in parser_matrix_ must be initialized
     bool first_time_set_;
 
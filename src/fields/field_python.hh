@@ -35,8 +35,13 @@ using namespace std;
  * This class assumes field python field with @p spacedim arguments containing coordinates of the given point.
  * The field should return  a tuple representing a vector value (possibly of size one for scalar fields)
  *
+ * Optionally (@p batch_ flag) the python function is called only once for a whole list of points.
+ * In such case it gets single argument: memoryview of doubles of shape (n_points, spacedim), which
+ * refers directly to the coordinates stored in C++ (no copy), and has to return an object supporting
+ * the buffer protocol (typically numpy array) containing n_points*n_comp doubles ordered by points.
+ * The function must not keep any reference to the passed memoryview.
+ *
  * TODO:
- * - use rather only one argument - tuple representing the whole point
  * - time fields
  * - set some parameter in the python module
  * - for fields with one component allow python fields returning the value directly
@@ -59,12 +64,17 @@ public:
      * Set the file and field to be called.
      * TODO: use FilePath
      */
-    void set_python_field_from_file( const FilePath &file_name, const string &func_name);
+    void set_python_field_from_file( const FilePath &file_name, const string &func_name, bool batch = false);
 
     /**
      * Set the source in a string and name of the field to be called.
      */
-    void set_python_field_from_string( const string &python_source, const string &func_name);
+    void set_python_field_from_string( const string &python_source, const string &func_name, bool batch = false);
+
+    /**
+     * Store mesh, necessary for computing coordinates of evaluation points in cache_update.
+     */
+    void set_mesh(const Mesh *mesh, bool boundary_domain) override;
 
     /**
      * Returns one value in one given point. ResultType can be used to avoid some costly calculation if the result is trivial.
@@ -77,6 +87,14 @@ public:
     virtual void value_list (const Armor::array &point_list, const ElementAccessor<spacedim> &elm,
                        std::vector<typename Value::return_type>  &value_list);
 
+    /**
+     * Overload @p FieldAlgorithmBase::cache_update
+     *
+     * In batch mode the python function is called once for all evaluation points of the region.
+     */
+    void cache_update(FieldValueCache<typename Value::element_type> &data_cache,
+                ElementCacheMap &cache_map, unsigned int region_idx) override;
+
 
     virtual ~FieldPython();
 
@@ -94,6 +112,26 @@ private:
      */
     inline void set_value(const Point &p, const ElementAccessor<spacedim> &elm, Value &value);
 
+    /**
+     * Implementation of batch call. Evaluates function in @p n_points points given
+     * by contiguous array @p points of coordinates and fills @p values (n_points*n_comp items).
+     */
+    void set_value_list(double *points, unsigned int n_points, std::vector<double> &values);
+
+    /**
+     * Add coordinates of used evaluation points of the cached element at position @p i_elm
+     * to @p point_list and their indices in FieldValueCache to @p cache_indices.
+     */
+    template <unsigned int dim>
+    void add_cache_points(ElementCacheMap &cache_map, unsigned int i_elm,
+            Armor::array &point_list, std::vector<int> &cache_indices);
+
+    /// Call the python function once for the whole list of points.
+    bool batch_;
+
+    /// Mesh, set in set_mesh.
+    const Mesh *mesh_;
+
 #ifdef FLOW123D_HAVE_PYTHON
     PyObject *p_func_;
     PyObject *p_module_;
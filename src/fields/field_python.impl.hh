@@ -21,6 +21,11 @@
 
 #include <type_traits>
 #include "fields/field_python.hh"
+#include "fields/eval_points.hh"
+#include "fem/mapping_p1.hh"
+#include "mesh/ref_element.hh"
+#include "mesh/accessors.hh"
+#include "mesh/mesh.h"
 
 /// Implementation.
 
@@ -43,6 +48,10 @@ const Input::Type::Record & FieldPython<spacedim, Value>::get_input_type()
 		.declare_key("function", it::String(), it::Default::obligatory(),
 				"Function in the given script that returns tuple containing components of the return type.\n"
 				"For NxM tensor values: tensor(row,col) = tuple( M*row + col ).")
+		.declare_key("batch", it::Bool(), it::Default("false"),
+				"If true, the function is called once for a list of points. It gets single argument: "
+				"memoryview of shape (n_points, 3) with coordinates of the points and has to return "
+				"an array (e.g. numpy.ndarray of float64) of n_points rows, each row ordered as the tuple above.")
 		//.declare_key("units", FieldAlgorithmBase<spacedim, Value>::get_field_algo_common_keys(), it::Default::optional(),
 		//		"Definition of unit.")
 		.close();
@@ -58,7 +67,9 @@ const int FieldPython<spacedim, Value>::registrar =
 
 template <int spacedim, class Value>
 FieldPython<spacedim, Value>::FieldPython(unsigned int n_comp)
-: FieldAlgorithmBase<spacedim, Value>( n_comp)
+: FieldAlgorithmBase<spacedim, Value>( n_comp),
+  batch_(false),
+  mesh_(nullptr)
 {
 	this->is_constant_in_space_ = false;
 
@@ -75,8 +86,10 @@ FieldPython<spacedim, Value>::FieldPython(unsigned int n_comp)
 
 
 template <int spacedim, class Value>
-void FieldPython<spacedim, Value>::set_python_field_from_string(FMT_UNUSED const string &python_source, FMT_UNUSED const string &func_name)
+void FieldPython<spacedim, Value>::set_python_field_from_string(FMT_UNUSED const string &python_source, FMT_UNUSED const string &func_name,
+        bool batch)
 {
+    batch_ = batch;
 #ifdef FLOW123D_HAVE_PYTHON
     p_module_ = PythonLoader::load_module_from_string("python_field_"+func_name, python_source);
     set_func(func_name);
@@ -91,14 +104,15 @@ template <int spacedim, class Value>
 void FieldPython<spacedim, Value>::init_from_input(const Input::Record &rec, const struct FieldAlgoBaseInitData& init_data) {
 	this->init_unit_conversion_coefficient(rec, init_data);
 
+    bool batch = rec.val<bool>("batch");
     Input::Iterator<string> it = rec.find<string>("script_string");
     if (it) {
-        set_python_field_from_string( *it, rec.val<string>("function") );
+        set_python_field_from_string( *it, rec.val<string>("function"), batch );
     } else {
         Input::Iterator<FilePath> it = rec.find<FilePath>("script_file");
         if (! it) xprintf(UsrErr, "Either 'script_string' or 'script_file' has to be specified in PythonField initialization.");
         try {
-            set_python_field_from_file( *it, rec.val<string>("function") );
+            set_python_field_from_file( *it, rec.val<string>("function"), batch );
         } INPUT_CATCH(FilePath::ExcFileOpen, FilePath::EI_Address_String, rec)
     }
 }
@@ -106,8 +120,10 @@ void FieldPython<spacedim, Value>::init_from_input(const Input::Record &rec, con
 
 
 template <int spacedim, class Value>
-void FieldPython<spacedim, Value>::set_python_field_from_file(FMT_UNUSED const FilePath &file_name, FMT_UNUSED const string &func_name)
+void FieldPython<spacedim, Value>::set_python_field_from_file(FMT_UNUSED const FilePath &file_name, FMT_UNUSED const string &func_name,
+        bool batch)
 {
+    batch_ = batch;
 #ifdef FLOW123D_HAVE_PYTHON
     p_module_ = PythonLoader::load_module_from_file( string(file_name) );
     set_func(func_name);
@@ -123,6 +139,20 @@ void FieldPython<spacedim, Value>::set_func(FMT_UNUSED const string &func_name)
 #ifdef FLOW123D_HAVE_PYTHON
 	p_func_ = PythonLoader::get_callable(p_module_, func_name);
 
+    unsigned int value_size=this->value_.n_rows() * this->value_.n_cols();
+    if (batch_) {
+        // try field call with one point
+        double point[spacedim];
+        for(unsigned int i = 0; i < spacedim; i++) point[i] = double(i);
+        std::vector<double> values;
+        set_value_list(point, 1, values);
+        if ( values.size() != value_size) {
+            xprintf(UsrErr, "Field '%s' from the python module: %s returns %d components but should return %d components.\n"
+                    ,func_name.c_str(), PyModule_GetName(p_module_), (unsigned int)values.size(), value_size);
+        }
+        return;
+    }
+
     p_args_ = PyTuple_New( spacedim );
 
     // try field call
@@ -140,8 +170,8 @@ void FieldPython<spacedim, Value>::set_func(FMT_UNUSED const string &func_name)
     }
 
     unsigned int size = PyTuple_Size( p_value_);
+    Py_CLEAR(p_value_);
 
-    unsigned int value_size=this->value_.n_rows() * this->value_.n_cols();
     if ( size !=  value_size) {
         xprintf(UsrErr, "Field '%s' from the python module: %s returns %d components but should return %d components.\n"
                 ,func_name.c_str(), PyModule_GetName(p_module_), size, value_size);
@@ -172,6 +202,21 @@ void FieldPython<spacedim, Value>::value_list (const Armor::array &point_list, c
 {
 	OLD_ASSERT_EQUAL( point_list.size(), value_list.size() );
     ASSERT_DBG( point_list.n_rows() == spacedim && point_list.n_cols() == 1 ).error("Invalid point size.\n");
+    if (batch_) {
+        std::vector<double> values;
+        set_value_list(point_list.data_, point_list.size(), values);
+        ASSERT_EQ(values.size(), point_list.size() * this->value_.n_rows() * this->value_.n_cols()).error("Invalid size of returned array.\n");
+        unsigned int pos = 0;
+        for(unsigned int i=0; i< point_list.size(); i++) {
+            Value envelope(value_list[i]);
+            for(unsigned int row=0; row < envelope.n_rows(); row++)
+                for(unsigned int col=0; col < envelope.n_cols(); col++, pos++)
+                    envelope(row,col) = values[pos];
+            envelope.scale(this->unit_conversion_coefficient_);
+        }
+        return;
+    }
+
     for(unsigned int i=0; i< point_list.size(); i++) {
         Value envelope(value_list[i]);
         OLD_ASSERT( envelope.n_rows()==this->value_.n_rows(),
@@ -182,6 +227,86 @@ void FieldPython<spacedim, Value>::value_list (const Armor::array &point_list, c
     }
 }
 
+
+template <int spacedim, class Value>
+void FieldPython<spacedim, Value>::set_mesh(const Mesh *mesh, FMT_UNUSED bool boundary_domain) {
+    mesh_ = mesh;
+}
+
+
+template <int spacedim, class Value>
+void FieldPython<spacedim, Value>::cache_update(FieldValueCache<typename Value::element_type> &data_cache,
+		ElementCacheMap &cache_map, unsigned int region_idx)
+{
+    ASSERT_PTR(mesh_).error("Mesh is not set!\n");
+    const auto &update_cache_data = cache_map.update_cache_data();
+    unsigned int region_in_cache = update_cache_data.region_cache_indices_range_.find(region_idx)->second;
+    unsigned int i_elm_begin = update_cache_data.region_element_cache_range_[region_in_cache];
+    unsigned int i_elm_end = update_cache_data.region_element_cache_range_[region_in_cache+1];
+
+    // collect coordinates of all used eval points of the region
+    Armor::array point_list(spacedim, 1);
+    point_list.reinit( (i_elm_end - i_elm_begin) * cache_map.eval_points()->max_size() );
+    std::vector<int> cache_indices;
+    for (unsigned int i_elm=i_elm_begin; i_elm<i_elm_end; ++i_elm) {
+        switch (mesh_->element_accessor( cache_map.elm_idx_on_position(i_elm) ).dim()) {
+        case 1:
+            add_cache_points<1>(cache_map, i_elm, point_list, cache_indices);
+            break;
+        case 2:
+            add_cache_points<2>(cache_map, i_elm, point_list, cache_indices);
+            break;
+        case 3:
+            add_cache_points<3>(cache_map, i_elm, point_list, cache_indices);
+            break;
+        }
+    }
+
+    if (point_list.size() == 0) return;
+
+    Armor::ArmaMat<typename Value::element_type, Value::NRows_, Value::NCols_> mat_value;
+    unsigned int n_rows = this->value_.n_rows(), n_cols = this->value_.n_cols();
+    if (batch_) {
+        std::vector<double> values;
+        set_value_list(point_list.data_, point_list.size(), values);
+        ASSERT_EQ(values.size(), point_list.size() * n_rows * n_cols).error("Invalid size of returned array.\n");
+        unsigned int pos = 0;
+        for (unsigned int i_point=0; i_point<point_list.size(); ++i_point) {
+            for (unsigned int row=0; row < n_rows; row++)
+                for (unsigned int col=0; col < n_cols; col++, pos++)
+                    mat_value(row,col) = this->unit_conversion_coefficient_ * values[pos];
+            data_cache.data().set(cache_indices[i_point]) = mat_value;
+        }
+    } else {
+        ElementAccessor<spacedim> elm;
+        for (unsigned int i_point=0; i_point<point_list.size(); ++i_point) {
+            set_value(point_list.vec<spacedim>(i_point), elm, this->value_);
+            for (unsigned int row=0; row < n_rows; row++)
+                for (unsigned int col=0; col < n_cols; col++)
+                    mat_value(row,col) = this->unit_conversion_coefficient_ * this->value_(row,col);
+            data_cache.data().set(cache_indices[i_point]) = mat_value;
+        }
+    }
+}
+
+
+template <int spacedim, class Value>
+template <unsigned int dim>
+void FieldPython<spacedim, Value>::add_cache_points(ElementCacheMap &cache_map, unsigned int i_elm,
+        Armor::array &point_list, std::vector<int> &cache_indices)
+{
+    std::shared_ptr<EvalPoints> eval_points = cache_map.eval_points();
+    ElementAccessor<spacedim> elm = mesh_->element_accessor( cache_map.elm_idx_on_position(i_elm) );
+    auto map = MappingP1<dim,spacedim>::element_map(elm);
+    for (unsigned int i_ep=0; i_ep<eval_points->size(dim); ++i_ep) {
+        int field_cache_idx = cache_map.get_field_value_cache_index(i_elm, i_ep);
+        if (field_cache_idx < 0) continue; // skip
+        point_list.append( MappingP1<dim,spacedim>::project_unit_to_real(
+                RefElement<dim>::local_to_bary(eval_points->local_point<dim>(i_ep)), map) );
+        cache_indices.push_back(field_cache_idx);
+    }
+}
+
 /**
 * Returns one vector value in one given point.
 */
@@ -201,7 +326,45 @@ void FieldPython<spacedim, Value>::set_value(FMT_UNUSED const Point &p, FMT_UNUS
         for(unsigned int col=0; col < value.n_cols(); col++, pos++)
             if ( std::is_integral< typename Value::element_type >::value ) value(row,col) = PyLong_AsLong( PyTuple_GetItem( p_value_, pos ) );
             else value(row,col) = PyFloat_AsDouble( PyTuple_GetItem( p_value_, pos ) );
+    Py_CLEAR(p_value_);
+
+#endif // FLOW123D_HAVE_PYTHON
+}
+
+
+template <int spacedim, class Value>
+void FieldPython<spacedim, Value>::set_value_list(FMT_UNUSED double *points, FMT_UNUSED unsigned int n_points,
+        FMT_UNUSED std::vector<double> &values)
+{
+#ifdef FLOW123D_HAVE_PYTHON
+    // memoryview of point coordinates without copy, reshaped to (n_points, spacedim)
+    PyObject *p_memory = PyMemoryView_FromMemory( reinterpret_cast<char *>(points),
+            n_points * spacedim * sizeof(double), PyBUF_READ );
+    PythonLoader::check_error();
+    PyObject *p_points = PyObject_CallMethod(p_memory, "cast", "s(II)", "d", n_points, (unsigned int)spacedim);
+    Py_DECREF(p_memory);
+    PythonLoader::check_error();
+
+    PyObject *p_result = PyObject_CallFunctionObjArgs(p_func_, p_points, NULL);
+    Py_DECREF(p_points);
+    PythonLoader::check_error();
+
+    Py_buffer view;
+    if ( PyObject_GetBuffer(p_result, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0 ) {
+        Py_DECREF(p_result);
+        THROW( ExcMessage() << EI_Message( "Batch python field doesn't return object supporting the buffer protocol (e.g. numpy array).\n" ));
+    }
+    std::string format = (view.format == nullptr) ? "B" : view.format;
+    if ( view.itemsize != sizeof(double) || format.back() != 'd' ) {
+        PyBuffer_Release(&view);
+        Py_DECREF(p_result);
+        THROW( ExcMessage() << EI_Message( "Batch python field has to return array of doubles (float64).\n" ));
+    }
 
+    const double *result_data = static_cast<const double *>(view.buf);
+    values.assign(result_data, result_data + view.len / sizeof(double));
+    PyBuffer_Release(&view);
+    Py_DECREF(p_result);
 #endif // FLOW123D_HAVE_PYTHON
 }
 
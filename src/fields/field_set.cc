@@ -170,6 +170,22 @@ bool FieldSet::changed() const {
 
 
 
+bool FieldSet::changed(Region reg) const {
+    bool changed_all=false;
+    for(auto field : field_list) changed_all = changed_all || field->changed(reg);
+    return changed_all;
+}
+
+
+
+bool FieldSet::changed(const RegionSet &region_set) const {
+    for(const Region &reg : region_set)
+        if (changed(reg)) return true;
+    return false;
+}
+
+
+
 bool FieldSet::is_constant(Region reg) const {
     bool const_all=true;
     for(auto field : field_list) const_all = const_all && field->is_constant(reg);
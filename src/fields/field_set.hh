@@ -227,6 +227,17 @@ public:
      */
     bool changed() const;
 
+    /**
+     * Collective interface to @p FieldCommonBase::changed(Region).
+     */
+    bool changed(Region reg) const;
+
+    /**
+     * Returns true if some field changed on some region of the given region set
+     * during the last call of set_time.
+     */
+    bool changed(const RegionSet &region_set) const;
+
     /**
      * Collective interface to @p FieldCommonBase::set_mesh().
      */
@@ -55,9 +55,9 @@ const unsigned int ElementCacheMap::undef_elem_idx = std::numeric_limits<unsigne
 
 ElementCacheMap::ElementCacheMap()
 : elm_idx_(ElementCacheMap::n_cached_elements, ElementCacheMap::undef_elem_idx),
+  cache_idx_(std::less<unsigned int>(), UpdateCacheHelper::IndexMap::allocator_type(arena_)),
+  update_data_(arena_),
   ready_to_reading_(false), element_eval_points_map_(nullptr), points_in_cache_(0) {
-    cache_idx_.reserve(ElementCacheMap::n_cached_elements);
-    update_data_.n_elements_ = 0;
 }
 
 
@@ -140,6 +140,12 @@ void ElementCacheMap::create_elements_points_map() {
 
 
 void ElementCacheMap::start_elements_update() {
+	// maps allocated from the arena are empty, so its memory can be reused
+	update_data_.region_cache_indices_map_.clear();
+	update_data_.region_cache_indices_range_.clear();
+	cache_idx_.clear();
+	arena_.reset();
+
 	update_data_.n_elements_ = 0;
 	ready_to_reading_ = false;
 }
@@ -172,7 +178,7 @@ void ElementCacheMap::add_to_region(ElementAccessor<3> elm) {
     // this can be used and avoid dupicit find and the condition.
 
     unsigned int reg_idx = elm.region_idx().idx();
-    typename std::unordered_map<unsigned int, RegionData>::iterator region_it = update_data_.region_cache_indices_map_.find(reg_idx);
+    UpdateCacheHelper::RegionDataMap::iterator region_it = update_data_.region_cache_indices_map_.find(reg_idx);
     if (region_it == update_data_.region_cache_indices_map_.end()) {
     	update_data_.region_cache_indices_map_.insert( {reg_idx, RegionData()} );
         region_it = update_data_.region_cache_indices_map_.find(reg_idx);
@@ -186,7 +192,7 @@ void ElementCacheMap::add_to_region(ElementAccessor<3> elm) {
 DHCellAccessor & ElementCacheMap::operator() (DHCellAccessor &dh_cell) const {
 	ASSERT_DBG(ready_to_reading_);
 	unsigned int elm_idx = dh_cell.elm_idx();
-	std::unordered_map<unsigned int, unsigned int>::const_iterator it = cache_idx_.find(elm_idx);
+	UpdateCacheHelper::IndexMap::const_iterator it = cache_idx_.find(elm_idx);
 	if ( it != cache_idx_.end() ) dh_cell.set_element_cache_index( it->second );
 	else dh_cell.set_element_cache_index( ElementCacheMap::undef_elem_idx );
     return dh_cell;
@@ -20,10 +20,12 @@
 #define FIELD_VALUE_CACHE_HH_
 
 #include <set>
+#include <map>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include "system/armor.hh"
+#include "system/arena_allocator.hh"
 #include "fields/eval_points.hh"
 #include "mesh/accessors.hh"
 
@@ -157,9 +159,23 @@ public:
      */
     class UpdateCacheHelper {
     public:
+        /// Map of region data, nodes are allocated from the arena of ElementCacheMap.
+        typedef std::map<unsigned int, RegionData, std::less<unsigned int>,
+                internal::ArenaAllocator< std::pair<const unsigned int, RegionData> > > RegionDataMap;
+        /// Map of indices, nodes are allocated from the arena of ElementCacheMap.
+        typedef std::map<unsigned int, unsigned int, std::less<unsigned int>,
+                internal::ArenaAllocator< std::pair<const unsigned int, unsigned int> > > IndexMap;
+
+        /// Constructor, maps allocate from given @p arena.
+        UpdateCacheHelper(internal::Arena &arena)
+        : region_cache_indices_map_(std::less<unsigned int>(), RegionDataMap::allocator_type(arena)),
+          region_cache_indices_range_(std::less<unsigned int>(), IndexMap::allocator_type(arena)),
+          n_elements_(0)
+        {}
+
         /// Maps of data of different regions in cache
     	/// TODO: auxiliary data membershould be removed or moved to sepaate structure.
-        std::unordered_map<unsigned int, RegionData> region_cache_indices_map_;
+        RegionDataMap region_cache_indices_map_;
 
         /// Holds positions of regions in cache
         /// TODO
@@ -167,7 +183,7 @@ public:
         /// ElementCacheMap table. This array gives start indices of the regions
         /// in array of all cached elements.
         /// The last value is number of actually cached elements.
-        std::unordered_map<unsigned int, unsigned int> region_cache_indices_range_;
+        IndexMap region_cache_indices_range_;
 
         /// Maps of begin and end positions of different regions data in FieldValueCache
         std::array<unsigned int, ElementCacheMap::n_cached_elements+1> region_value_cache_range_;
@@ -260,13 +276,19 @@ protected:
     /// Add element to appropriate region data of update_data_ object
     void add_to_region(ElementAccessor<3> elm);
 
+    /**
+     * Memory of the maps rebuilt in every cache update (cache_idx_ and maps of update_data_).
+     * Reset in start_elements_update() when the maps are empty.
+     */
+    internal::Arena arena_;
+
     /// Vector of element indexes stored in cache.
     /// TODO: could be moved to UpdateCacheHelper structure
     std::vector<unsigned int> elm_idx_;
 
     /// Map of element indices stored in cache, allows reverse search to previous vector.
     /// TODO: could be moved to UpdateCacheHelper structure
-    std::unordered_map<unsigned int, unsigned int> cache_idx_;
+    UpdateCacheHelper::IndexMap cache_idx_;
 
     /// Pointer to EvalPoints
     std::shared_ptr<EvalPoints> eval_points_;
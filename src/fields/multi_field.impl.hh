@@ -77,6 +77,7 @@ MultiField<spacedim,Value> &MultiField<spacedim,Value>::operator=(const MultiFie
 	shared_->comp_names_ = comp_names;
     shared_->is_fully_initialized_ = false;
 	set_time_result_ = other.set_time_result_;
+	changed_regions_ = other.changed_regions_;
 	last_time_ = other.last_time_;
 	last_limit_side_ = other.last_limit_side_;
 	is_jump_time_ = other.is_jump_time_;
@@ -147,10 +148,14 @@ bool MultiField<spacedim, Value>::set_time(
 
 	// set time for sub fields
 	set_time_result_ = TimeStatus::constant;
+	changed_regions_.assign(mesh()->region_db().size(), false);
 	is_jump_time_=false;
 	for( SubFieldType &field : sub_fields_) {
-            if (field.set_time(time, limit_side))
+            if (field.set_time(time, limit_side)) {
                 set_time_result_ = TimeStatus::changed;
+                for (const Region &reg : mesh()->region_db().get_region_set("ALL"))
+                    if (field.changed(reg)) changed_regions_[reg.idx()] = true;
+            }
             is_jump_time_ = is_jump_time_ ||  field.is_jump_time();
 	}
     return (set_time_result_ == TimeStatus::changed);
@@ -109,12 +109,7 @@ protected:
             double water_content = 0;
             double phead = ad_->p_edge_solution[ edge_indices_[i] ];
             if (genuchten_on) {
-
-                  fadbad::B<double> x_phead(phead);
-                  fadbad::B<double> evaluated( ad_->soil_model_->water_content_diff(x_phead) );
-                  evaluated.diff(0,1);
-                  water_content = evaluated.val();
-                  capacity = x_phead.d(0);
+                  water_content = ad_->soil_model_->water_content_capacity(phead, capacity);
             }
             ad_->capacity[ cr_disc_dofs[i] ] = capacity + storativity;
             water_content_vec[ cr_disc_dofs[i] ] = water_content + storativity * phead;
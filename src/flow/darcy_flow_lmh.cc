@@ -50,6 +50,7 @@
 #include "flow/assembly_lmh.hh"
 #include "flow/darcy_flow_lmh.hh"
 #include "flow/darcy_flow_mh_output.hh"
+#include "flow/nonlinear_solver_tools.hh"
 
 #include "tools/time_governor.hh"
 #include "fields/field_algo_base.hh"
@@ -114,6 +115,13 @@ const it::Record & DarcyLMH::get_input_type() {
             "If a stagnation of the nonlinear solver is detected the solver stops. "
             "A divergence is reported by default, forcing the end of the simulation. By setting this flag to 'true', the solver "
             "ends with convergence success on stagnation, but it reports warning about it.")
+        .declare_key("max_line_search_steps", it::Integer(0), it::Default("0"),
+            "Maximal number of halvings of the nonlinear step in the backtracking line search. "
+            "The step is shortened until the residual decreases sufficiently. Zero value switches the line search off.")
+        .declare_key("adaptive_linear_tolerance", it::Bool(), it::Default("false"),
+            "If true, the relative tolerance of the linear solver is adapted in each nonlinear iteration "
+            "according to the decrease of the nonlinear residual (Eisenstat-Walker forcing term). "
+            "The 'r_tol' of the linear solver, if set explicitly, takes precedence.")
         .close();
 
     DarcyLMH::EqData eq_data;
@@ -567,6 +575,9 @@ void DarcyLMH::solve_nonlinear()
     this->max_n_it_  = nl_solver_rec.val<unsigned int>("max_it");
     this->min_n_it_  = nl_solver_rec.val<unsigned int>("min_it");
     if (this->min_n_it_ > this->max_n_it_) this->min_n_it_ = this->max_n_it_;
+    const unsigned int max_line_search_steps = nl_solver_rec.val<unsigned int>("max_line_search_steps");
+    const bool adaptive_linear_tolerance = nl_solver_rec.val<bool>("adaptive_linear_tolerance");
+    double forcing_term = 0.1; // relative linear tolerance for the adaptive case
 
     if (! is_linear_common) {
         // set tolerances of the linear solver unless they are set by user.
@@ -599,7 +610,15 @@ void DarcyLMH::solve_nonlinear()
             data_->p_edge_solution_previous.local_to_ghost_end();
         }
 
+        if (! is_linear_common && adaptive_linear_tolerance) {
+            forcing_term = eisenstat_walker_forcing_term(convergence_history, residual_norm, forcing_term, this->tolerance_);
+            lin_sys_schur().set_tolerances(forcing_term, 0.01*this->tolerance_, 100);
+        }
+
+        StepMetrics::PhaseTimer solve_timer(time_->metrics(), StepMetrics::solve);
         LinSys::SolveInfo si = lin_sys_schur().solve();
+        solve_timer.stop();
+        time_->metrics().add_linear_solve(si.n_iterations);
         MessageOut().fmt("[schur solver] lin. it: {}, reason: {}, residual: {}\n",
         		si.n_iterations, si.converged_reason, lin_sys_schur().compute_residual());
         
@@ -623,9 +642,19 @@ void DarcyLMH::solve_nonlinear()
         assembly_linear_system();
 
         residual_norm = lin_sys_schur().compute_residual();
+
+        // backtracking line search: halve the step until sufficient decrease of the residual
+        residual_norm = backtracking_line_search(data_->p_edge_solution.petsc_vec(), data_->p_edge_solution_previous.petsc_vec(),
+                residual_norm, convergence_history.back(), max_line_search_steps,
+                [this]() {
+                    data_changed_=true; // assembly_linear_system() resets the flag
+                    assembly_linear_system();
+                    return lin_sys_schur().compute_residual();
+                });
         MessageOut().fmt("[nonlinear solver] it: {} lin. it: {}, reason: {}, residual: {}\n",
         		nonlinear_iteration_, si.n_iterations, si.converged_reason, residual_norm);
     }
+    time_->metrics().add_nonlinear_iterations(nonlinear_iteration_);
     
     reconstruct_solution_from_schur(data_->multidim_assembler);
 
@@ -651,6 +680,7 @@ void DarcyLMH::accept_time_step()
 
 void DarcyLMH::output_data() {
     START_TIMER("Darcy output data");
+    StepMetrics::PhaseTimer metrics_timer(time_->metrics(), StepMetrics::output);
     
     // print_matlab_matrix("matrix_" + std::to_string(time_->step().index()));
     
@@ -912,6 +942,8 @@ void DarcyLMH::create_linear_system(Input::AbstractRecord in_rec) {
             lin_sys_schur().set_positive_definite();
             lin_sys_schur().set_solution( data_->p_edge_solution.petsc_vec() );
             lin_sys_schur().set_symmetric();
+            // positions of edge unknowns for algebraic multigrid preconditioners
+            lin_sys_schur().set_coordinates(3, data_->dh_cr_->own_dof_coordinates());
             
 //             LinSys_PETSC *schur1, *schur2;
 
@@ -1000,27 +1032,36 @@ void DarcyLMH::reconstruct_solution_from_schur(MultidimAssembly& assembler)
 
     data_->full_solution.zero_entries();
     data_->p_edge_solution.local_to_ghost_begin();
-    data_->p_edge_solution.local_to_ghost_end();
 
     balance_->start_flux_assembly(data_->water_balance_idx);
     balance_->start_source_assembly(data_->water_balance_idx);
     balance_->start_mass_assembly(data_->water_balance_idx);
 
-    for ( DHCellAccessor dh_cell : data_->dh_->own_range() ) {
-        unsigned int dim = dh_cell.dim();
-        assembler[dim-1]->assemble_reconstruct(dh_cell);
+    // cells using only own values of p_edge_solution are reconstructed while the ghost values are updated
+    for ( unsigned int loc_idx : data_->dh_->own_interior_cells() ) {
+        DHCellAccessor dh_cell(data_->dh_.get(), loc_idx);
+        assembler[dh_cell.dim()-1]->assemble_reconstruct(dh_cell);
+    }
+
+    data_->p_edge_solution.local_to_ghost_end();
+
+    for ( unsigned int loc_idx : data_->dh_->own_interface_cells() ) {
+        DHCellAccessor dh_cell(data_->dh_.get(), loc_idx);
+        assembler[dh_cell.dim()-1]->assemble_reconstruct(dh_cell);
     }
 
     data_->full_solution.local_to_ghost_begin();
-    data_->full_solution.local_to_ghost_end();
 
     balance_->finish_mass_assembly(data_->water_balance_idx);
     balance_->finish_source_assembly(data_->water_balance_idx);
     balance_->finish_flux_assembly(data_->water_balance_idx);
+
+    data_->full_solution.local_to_ghost_end();
 }
 
 void DarcyLMH::assembly_linear_system() {
     START_TIMER("DarcyFlowMH::assembly_linear_system");
+    StepMetrics::PhaseTimer metrics_timer(time_->metrics(), StepMetrics::assembly);
 //     DebugOut() << "DarcyLMH::assembly_linear_system\n";
 
     data_->p_edge_solution.local_to_ghost_begin();
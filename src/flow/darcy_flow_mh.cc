@@ -50,6 +50,7 @@
 #include "flow/assembly_mh.hh"
 #include "flow/darcy_flow_mh.hh"
 #include "flow/darcy_flow_mh_output.hh"
+#include "flow/nonlinear_solver_tools.hh"
 
 #include "tools/time_governor.hh"
 #include "fields/field_algo_base.hh"
@@ -144,6 +145,13 @@ const it::Record & DarcyMH::get_input_type() {
             "If a stagnation of the nonlinear solver is detected the solver stops. "
             "A divergence is reported by default, forcing the end of the simulation. By setting this flag to 'true', the solver "
             "ends with convergence success on stagnation, but it reports warning about it.")
+        .declare_key("max_line_search_steps", it::Integer(0), it::Default("0"),
+            "Maximal number of halvings of the nonlinear step in the backtracking line search. "
+            "The step is shortened until the residual decreases sufficiently. Zero value switches the line search off.")
+        .declare_key("adaptive_linear_tolerance", it::Bool(), it::Default("false"),
+            "If true, the relative tolerance of the linear solver is adapted in each nonlinear iteration "
+            "according to the decrease of the nonlinear residual (Eisenstat-Walker forcing term). "
+            "The 'r_tol' of the linear solver, if set explicitly, takes precedence.")
         .close();
 
     DarcyMH::EqData eq_data;
@@ -639,6 +647,9 @@ void DarcyMH::solve_nonlinear()
     this->max_n_it_  = nl_solver_rec.val<unsigned int>("max_it");
     this->min_n_it_  = nl_solver_rec.val<unsigned int>("min_it");
     if (this->min_n_it_ > this->max_n_it_) this->min_n_it_ = this->max_n_it_;
+    const unsigned int max_line_search_steps = nl_solver_rec.val<unsigned int>("max_line_search_steps");
+    const bool adaptive_linear_tolerance = nl_solver_rec.val<bool>("adaptive_linear_tolerance");
+    double forcing_term = 0.1; // relative linear tolerance for the adaptive case
 
     if (! is_linear_common) {
         // set tolerances of the linear solver unless they are set by user.
@@ -668,7 +679,15 @@ void DarcyMH::solve_nonlinear()
 
         if (! is_linear_common)
             VecCopy( schur0->get_solution(), save_solution);
+        if (! is_linear_common && adaptive_linear_tolerance) {
+            forcing_term = eisenstat_walker_forcing_term(convergence_history, residual_norm, forcing_term, this->tolerance_);
+            schur0->set_tolerances(forcing_term, 0.01*this->tolerance_, 100);
+        }
+
+        StepMetrics::PhaseTimer solve_timer(time_->metrics(), StepMetrics::solve);
         LinSys::SolveInfo si = schur0->solve();
+        solve_timer.stop();
+        time_->metrics().add_linear_solve(si.n_iterations);
         nonlinear_iteration_++;
 
         // hack to make BDDC work with empty compute_residual
@@ -689,9 +708,19 @@ void DarcyMH::solve_nonlinear()
         assembly_linear_system();
 
         residual_norm = schur0->compute_residual();
+
+        // backtracking line search: halve the step until sufficient decrease of the residual
+        residual_norm = backtracking_line_search(schur0->get_solution(), save_solution,
+                residual_norm, convergence_history.back(), max_line_search_steps,
+                [this]() {
+                    data_changed_=true; // assembly_linear_system() resets the flag
+                    assembly_linear_system();
+                    return schur0->compute_residual();
+                });
         MessageOut().fmt("[nonlinear solver] it: {} lin. it: {}, reason: {}, residual: {}\n",
         		nonlinear_iteration_, si.n_iterations, si.converged_reason, residual_norm);
     }
+    time_->metrics().add_nonlinear_iterations(nonlinear_iteration_);
     chkerr(VecDestroy(&save_solution));
     this -> postprocess();
 
@@ -747,6 +776,7 @@ void DarcyMH::postprocess()
 
 void DarcyMH::output_data() {
     START_TIMER("Darcy output data");
+    StepMetrics::PhaseTimer metrics_timer(time_->metrics(), StepMetrics::output);
     
     //print_matlab_matrix("matrix_" + std::to_string(time_->step().index()));
     
@@ -1062,6 +1092,7 @@ void DarcyMH::create_linear_system(Input::AbstractRecord in_rec) {
 
 void DarcyMH::assembly_linear_system() {
     START_TIMER("DarcyFlowMH_Steady::assembly_linear_system");
+    StepMetrics::PhaseTimer metrics_timer(time_->metrics(), StepMetrics::assembly);
 
     data_->is_linear=true;
     bool is_steady = zero_time_term();
@@ -0,0 +1,54 @@
+/*!
+ *
+ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ * 
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ * 
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * 
+ * @file    nonlinear_solver_tools.cc
+ * @ingroup flow
+ * @brief   Globalization and inexact solve tools shared by the nonlinear solvers of DarcyMH and DarcyLMH.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "system/logger.hh"
+#include "flow/nonlinear_solver_tools.hh"
+
+
+double backtracking_line_search(Vec solution, Vec prev_solution, double residual_norm, double prev_residual_norm,
+        unsigned int max_steps, const std::function<double()> &eval_residual)
+{
+    double alpha = 1; // how much of the full step
+    for (unsigned int i_ls=0; i_ls < max_steps
+            && residual_norm > (1 - 1e-4*alpha) * prev_residual_norm; ++i_ls) {
+        alpha *= 0.5;
+        VecAXPBY(solution, 0.5, 0.5, prev_solution);
+        residual_norm = eval_residual();
+        MessageOut().fmt("[nonlinear solver] line search step: {}, residual: {}\n", alpha, residual_norm);
+    }
+    return residual_norm;
+}
+
+
+double eisenstat_walker_forcing_term(const std::vector<double> &convergence_history, double residual_norm,
+        double forcing_term, double tolerance)
+{
+    const double ew_gamma = 0.9, ew_alpha = 0.5*(1+std::sqrt(5.0));
+    if (convergence_history.size() > 1 && convergence_history[convergence_history.size()-2] > 0) {
+        double eta = ew_gamma * std::pow(residual_norm / convergence_history[convergence_history.size()-2], ew_alpha);
+        double eta_safe = ew_gamma * std::pow(forcing_term, ew_alpha);
+        if (eta_safe > 0.1) eta = std::max(eta, eta_safe);
+        forcing_term = std::min(eta, 0.9);
+    }
+    // avoid oversolving close to the nonlinear tolerance
+    if (residual_norm > 0) forcing_term = std::max(forcing_term, 0.5*tolerance/residual_norm);
+    return forcing_term;
+}
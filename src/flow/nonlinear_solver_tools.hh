@@ -0,0 +1,52 @@
+/*!
+ *
+ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ * 
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ * 
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * 
+ * @file    nonlinear_solver_tools.hh
+ * @ingroup flow
+ * @brief   Globalization and inexact solve tools shared by the nonlinear solvers of DarcyMH and DarcyLMH.
+ */
+
+#ifndef SRC_FLOW_NONLINEAR_SOLVER_TOOLS_HH_
+#define SRC_FLOW_NONLINEAR_SOLVER_TOOLS_HH_
+
+#include <functional>
+#include <vector>
+#include "petscvec.h"
+
+
+/**
+ * Backtracking line search of the nonlinear iteration.
+ *
+ * The step from @p prev_solution to @p solution (full step, residual norm @p residual_norm) is halved
+ * until the residual satisfies the sufficient decrease condition with respect to @p prev_residual_norm
+ * or @p max_steps halvings are done. The functor @p eval_residual has to reassemble the system
+ * for the current @p solution and return its residual norm.
+ *
+ * Returns residual norm of the accepted step, @p solution holds the accepted step.
+ */
+double backtracking_line_search(Vec solution, Vec prev_solution, double residual_norm, double prev_residual_norm,
+        unsigned int max_steps, const std::function<double()> &eval_residual);
+
+/**
+ * Eisenstat-Walker forcing term (choice 2 with safeguards), i.e. the relative tolerance
+ * of the linear solver in the next nonlinear iteration.
+ *
+ * @param convergence_history  Residual norms of the previous nonlinear iterations, the last one is @p residual_norm.
+ * @param forcing_term         Forcing term of the previous iteration.
+ * @param tolerance            Tolerance of the nonlinear solver, used to avoid oversolving.
+ */
+double eisenstat_walker_forcing_term(const std::vector<double> &convergence_history, double residual_norm,
+        double forcing_term, double tolerance);
+
+
+#endif /* SRC_FLOW_NONLINEAR_SOLVER_TOOLS_HH_ */
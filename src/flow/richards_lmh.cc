@@ -94,6 +94,14 @@ const it::Record & RichardsLMH::get_input_type() {
             "That will allow usage of different soil model in a single simulation.")
         .declare_key("cut_fraction", it::Double(0.0,1.0), it::Default("0.999"),
                 "Fraction of the water content where we cut  and rescale the curve.")
+        .declare_key("tabulated", it::Bool(), it::Default("false"),
+                "Evaluate the soil model from tables precomputed for every set of soil parameters "
+                "instead of the analytic formulas.")
+        .declare_key("table_points_per_decade", it::Integer(1), it::Default("100"),
+                "Number of table intervals per decade of the capillary suction.")
+        .declare_key("table_tolerance", it::Double(0.0), it::Default("0.0"),
+                "If positive, the relative interpolation error of every table is checked and a warning is printed "
+                "when it exceeds the tolerance.")
         .close();
 
     RichardsLMH::EqData eq_data;
@@ -139,6 +147,10 @@ void RichardsLMH::initialize_specific() {
         data_->soil_model_ = std::make_shared<SoilModel_Irmay>(fraction);
     else
         ASSERT(false);
+    if (model_rec.val<bool>("tabulated"))
+        data_->soil_model_ = std::make_shared<SoilModelTabulated>(data_->soil_model_,
+                model_rec.val<unsigned int>("table_points_per_decade"),
+                model_rec.val<double>("table_tolerance"));
 
     // create edge vectors
     data_->water_content_previous_time = data_->dh_cr_disc_->create_vector();
@@ -15,6 +15,17 @@
 #include "flow/soil_models.hh"
 #include "tools/include_fadbad.hh" // for "fadbad.h", "badiff.h", "fadiff.h"
 
+
+double SoilModelBase::water_content_capacity(const double &p_head, double &capacity)
+{
+    DiffDouble x_phead(p_head);
+    DiffDouble evaluated( this->water_content_diff(x_phead) );
+    evaluated.diff(0,1);
+    capacity = x_phead.d(0);
+    return evaluated.val();
+}
+
+
 template <class Model>
 SoilModelImplBase<Model>::SoilModelImplBase(double cut_fraction)
 : cut_fraction_(cut_fraction)
@@ -64,6 +75,12 @@ auto SoilModelImplBase<Model>::water_content_diff(const DiffDouble &p_head)->Dif
     return model_.water_content_(p_head);
 }
 
+template <class Model>
+double SoilModelImplBase<Model>::saturation_head() const
+{
+    return model_.saturation_head_();
+}
+
 
 
 
@@ -185,3 +202,195 @@ template class SoilModelImplBase<internal::VanGenuchten>;
 template class SoilModelImplBase<internal::Irmay>;
 
 
+
+
+
+/*******************************************************************************
+ * Implementation of SoilModelTabulated
+ */
+
+const unsigned int SoilModelTabulated::max_tables;
+
+SoilModelTabulated::SoilModelTabulated(std::shared_ptr<SoilModelBase> model, unsigned int points_per_decade, double check_tolerance)
+: model_(model),
+  n_intervals_( (unsigned int)(t_max - t_min) * points_per_decade ),
+  dt_( (t_max - t_min) / n_intervals_ ),
+  check_tolerance_(check_tolerance),
+  table_(nullptr),
+  max_tables_warned_(false)
+{
+    ASSERT_PTR(model_).error();
+    ASSERT_GT(points_per_decade, 0).error();
+}
+
+
+void SoilModelTabulated::reset(SoilData soil)
+{
+    model_->reset(soil);
+
+    std::array<double, 6> key = {{ soil.n, soil.alpha, soil.Qr, soil.Qs, soil.Ks, soil.cut_fraction }};
+    auto it = tables_.find(key);
+    if (it != tables_.end()) {
+        table_ = &(it->second);
+    } else if (tables_.size() < max_tables) {
+        Table &table = tables_[key];
+        make_table(table, soil);
+        table_ = &table;
+    } else {
+        if (! max_tables_warned_) {
+            WarningOut().fmt("Number of soil model tables exceeds {}, analytic soil model is used for further soil parameters.\n",
+                    max_tables);
+            max_tables_warned_ = true;
+        }
+        table_ = nullptr;
+    }
+}
+
+
+void SoilModelTabulated::make_table(Table &table, const SoilData &soil)
+{
+    table.h_sat = model_->saturation_head();
+    table.alpha = soil.alpha;
+    table.K.resize(n_intervals_+1);
+    table.dK.resize(n_intervals_+1);
+    table.Q.resize(n_intervals_+1);
+    table.dQ.resize(n_intervals_+1);
+
+    for (unsigned int i=0; i<=n_intervals_; i++) {
+        // h = h_sat - 10^t / alpha,  dh/dt = -ln(10) * (h_sat - h)
+        double suction = std::pow(10.0, t_min + i*dt_) / table.alpha;
+        double h = table.h_sat - suction;
+        double dh_dt = -std::log(10.0) * suction;
+
+        DiffDouble x_phead(h);
+        DiffDouble evaluated( model_->conductivity_diff(x_phead) );
+        evaluated.diff(0,1);
+        table.K[i] = evaluated.val();
+        table.dK[i] = x_phead.d(0) * dh_dt;
+
+        table.Q[i] = model_->water_content_capacity(h, table.dQ[i]);
+        table.dQ[i] *= dh_dt;
+    }
+
+    // Fritsch-Carlson limiter of the derivatives ensures monotone interpolation
+    for (auto col : { std::make_pair(&table.K, &table.dK), std::make_pair(&table.Q, &table.dQ) }) {
+        std::vector<double> &val = *col.first, &diff = *col.second;
+        for (unsigned int i=0; i<n_intervals_; i++) {
+            double delta = (val[i+1] - val[i]) / dt_;
+            if (delta == 0.0) {
+                diff[i] = diff[i+1] = 0.0;
+                continue;
+            }
+            double a = diff[i] / delta, b = diff[i+1] / delta;
+            if (a < 0) diff[i] = a = 0.0;
+            if (b < 0) diff[i+1] = b = 0.0;
+            double r2 = a*a + b*b;
+            if (r2 > 9.0) {
+                double tau = 3.0 / std::sqrt(r2);
+                diff[i] = tau * a * delta;
+                diff[i+1] = tau * b * delta;
+            }
+        }
+    }
+
+    // check the interpolation error at midpoints of intervals, values below 1e-6 of the maximum
+    // (e.g. the clamped conductivity of the analytic model) are compared in absolute sense
+    table.max_error = 0.0;
+    if (check_tolerance_ > 0.0) {
+        double K_max = *std::max_element(table.K.begin(), table.K.end());
+        double Q_max = *std::max_element(table.Q.begin(), table.Q.end());
+        double d_val;
+        for (unsigned int i=0; i<n_intervals_; i++) {
+            double h = table.h_sat - std::pow(10.0, t_min + (i+0.5)*dt_) / table.alpha;
+            double K = model_->conductivity(h), Q = model_->water_content(h);
+            double K_err = std::abs(interpolate(table.K, table.dK, i, 0.5, d_val) - K) / std::max(K, 1e-6 * K_max);
+            double Q_err = std::abs(interpolate(table.Q, table.dQ, i, 0.5, d_val) - Q) / std::max(Q, 1e-6 * Q_max);
+            table.max_error = std::max(table.max_error, std::max(K_err, Q_err));
+        }
+        if (table.max_error > check_tolerance_)
+            WarningOut().fmt("Relative error {} of the tabulated soil model exceeds tolerance {}.\n",
+                    table.max_error, check_tolerance_);
+    }
+}
+
+
+inline bool SoilModelTabulated::locate(double p_head, unsigned int &i, double &s) const
+{
+    double suction = table_->alpha * (table_->h_sat - p_head);
+    if (! (suction > 0.0)) return false;
+    double t = (std::log10(suction) - t_min) / dt_;
+    if (t < 0.0 || t >= n_intervals_) return false;
+    i = (unsigned int)t;
+    s = t - i;
+    return true;
+}
+
+
+inline double SoilModelTabulated::interpolate(const std::vector<double> &val, const std::vector<double> &diff,
+                                              unsigned int i, double s, double &d_val) const
+{
+    // cubic Hermite basis on the interval <t_i, t_i+1>
+    double s2 = s*s, s3 = s2*s;
+    d_val = (6*s2 - 6*s) / dt_ * (val[i] - val[i+1])
+            + (3*s2 - 4*s + 1) * diff[i] + (3*s2 - 2*s) * diff[i+1];
+    return (2*s3 - 3*s2 + 1) * val[i] + (-2*s3 + 3*s2) * val[i+1]
+           + dt_ * ( (s3 - 2*s2 + s) * diff[i] + (s3 - s2) * diff[i+1] );
+}
+
+
+double SoilModelTabulated::conductivity( const double &p_head) const
+{
+    unsigned int i;
+    double s, d_val;
+    if (table_ != nullptr && locate(p_head, i, s))
+        return interpolate(table_->K, table_->dK, i, s, d_val);
+    return model_->conductivity(p_head);
+}
+
+
+auto SoilModelTabulated::conductivity_diff(const DiffDouble &p_head)->DiffDouble const
+{
+    return model_->conductivity_diff(p_head);
+}
+
+
+double SoilModelTabulated::water_content( const double &p_head) const
+{
+    unsigned int i;
+    double s, d_val;
+    if (table_ != nullptr && locate(p_head, i, s))
+        return interpolate(table_->Q, table_->dQ, i, s, d_val);
+    return model_->water_content(p_head);
+}
+
+
+auto SoilModelTabulated::water_content_diff(const DiffDouble &p_head)->DiffDouble const
+{
+    return model_->water_content_diff(p_head);
+}
+
+
+double SoilModelTabulated::water_content_capacity(const double &p_head, double &capacity)
+{
+    unsigned int i;
+    double s;
+    if (table_ != nullptr && locate(p_head, i, s)) {
+        double water_content = interpolate(table_->Q, table_->dQ, i, s, capacity);
+        // dt/dh = -1 / (ln(10) * (h_sat - h))
+        capacity /= -std::log(10.0) * (table_->h_sat - p_head);
+        return water_content;
+    }
+    return model_->water_content_capacity(p_head, capacity);
+}
+
+
+double SoilModelTabulated::saturation_head() const
+{
+    return model_->saturation_head();
+}
+
+
+double SoilModelTabulated::table_error() const
+{
+    return (table_ != nullptr) ? table_->max_error : 0.0;
+}
@@ -12,6 +12,10 @@
 // #include "badiff.h"  // for B::d, B::deriv, B::diff, B::getBTypeNameHV, B::o...
 // #include "fadbad.h"  // for B
 #include "tools/include_fadbad.hh" // for "fadbad.h", "badiff.h"
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
 namespace internal { class Irmay; }
 namespace internal { class VanGenuchten; }
 
@@ -67,6 +71,12 @@ public:
     virtual double water_content( const double &phead) const =0;
     virtual auto water_content_diff(const DiffDouble &p_head)->DiffDouble const =0;
 
+    /// Water content and its derivative (capacity). Default implementation uses @p water_content_diff.
+    virtual double water_content_capacity(const double &p_head, double &capacity);
+
+    /// Pressure head above which both the conductivity and the water content are constant.
+    virtual double saturation_head() const =0;
+
     virtual ~SoilModelBase() {};
 };
 
@@ -92,6 +102,8 @@ public:
     double water_content( const double &p_head) const override;
     auto water_content_diff(const DiffDouble &p_head)->DiffDouble const override;
 
+    double saturation_head() const override;
+
     ~SoilModelImplBase() {}
 
 private:
@@ -116,6 +128,9 @@ public:
     template <class T>
     T water_content_(const T &h) const;
 
+    inline double saturation_head_() const
+    { return Hs; }
+
 protected:
 
     template <class T> T Q_rel(const T &h) const;
@@ -157,6 +172,85 @@ typedef SoilModelImplBase<internal::Irmay> SoilModel_Irmay;
 
 
 
+/**
+ * Soil model evaluated from precomputed tables of an analytic model.
+ *
+ * Values and derivatives of the conductivity and the water content are tabulated on
+ * a uniform grid in t = log10( alpha*(Hs - h) ), where Hs is the saturation head, and interpolated
+ * by monotone cubic Hermite splines. A table is built once for every distinct SoilData
+ * (typically once per region). Outside of the tabulated range as well as for the derivatives
+ * through FADBAD the analytic model is used.
+ */
+class SoilModelTabulated : public SoilModelBase {
+public:
+    typedef SoilModelBase::DiffDouble DiffDouble;
+
+    /**
+     * @param model              Analytic model to tabulate.
+     * @param points_per_decade  Number of table intervals per decade of the suction.
+     * @param check_tolerance    If positive, interpolation error of every new table is checked
+     *                           against the analytic model and a warning is printed if it is exceeded.
+     */
+    SoilModelTabulated(std::shared_ptr<SoilModelBase> model, unsigned int points_per_decade = 100, double check_tolerance = 0.0);
+
+    void reset(SoilData soil) override;
+
+    double conductivity( const double &p_head) const override;
+    auto conductivity_diff(const DiffDouble &p_head)->DiffDouble const override;
+
+    double water_content( const double &p_head) const override;
+    auto water_content_diff(const DiffDouble &p_head)->DiffDouble const override;
+
+    double water_content_capacity(const double &p_head, double &capacity) override;
+
+    double saturation_head() const override;
+
+    /// Maximal relative interpolation error of the current table (computed only if the check is on).
+    double table_error() const;
+
+    /// Range of the table in log10 of the scaled suction.
+    static constexpr double t_min = -6.0, t_max = 6.0;
+
+    /// Maximal number of tables, analytic model is used for further soil parameters.
+    static const unsigned int max_tables = 1000;
+
+private:
+    struct Table {
+        double h_sat;          ///< Saturation head.
+        double alpha;          ///< Pressure head scaling.
+        /// Values and derivatives with respect to t in the table nodes.
+        std::vector<double> K, dK, Q, dQ;
+        double max_error;      ///< Max. relative error at midpoints of intervals.
+    };
+
+    /// Build table for the current soil parameters of the analytic model.
+    void make_table(Table &table, const SoilData &soil);
+
+    /**
+     * Find table interval @p i and local coordinate @p s of the pressure head,
+     * return false if @p p_head is out of the table.
+     */
+    bool locate(double p_head, unsigned int &i, double &s) const;
+
+    /// Interpolate table column @p val with derivatives @p diff, derivative with respect to t is returned in @p d_val.
+    double interpolate(const std::vector<double> &val, const std::vector<double> &diff,
+                       unsigned int i, double s, double &d_val) const;
+
+    std::shared_ptr<SoilModelBase> model_;
+    unsigned int n_intervals_;
+    double dt_;
+    double check_tolerance_;
+
+    /// Tables for all processed soil parameters.
+    std::map< std::array<double, 6>, Table > tables_;
+    /// Table of the current soil parameters, NULL if analytic model is used.
+    const Table *table_;
+    /// Warning about exceeded number of tables was printed.
+    bool max_tables_warned_;
+};
+
+
+
 
 
 
@@ -925,6 +925,29 @@ struct TypeDispatch<FilePath> {
 };
 
 
+/**
+ * Read value of item @p idx of the array given by address @p a. Accessors and other values are read
+ * through the Address of the item, that is necessary for error messages.
+ */
+template<class Dispatch>
+inline typename std::enable_if<!std::is_same<typename Dispatch::InputType, Input::Type::Double>::value, typename Dispatch::ReadType>::type
+read_array_item(const Address &a, unsigned int idx, const typename Dispatch::InputType &t) {
+    auto new_address = a.down(idx);
+    ASSERT_PTR(new_address->storage_head()).error();
+    return Dispatch::value(*new_address, t);
+}
+
+/**
+ * Doubles are read directly from the array storage. This avoids creation of an Address
+ * for every item of large numeric arrays.
+ */
+template<class Dispatch>
+inline typename std::enable_if<std::is_same<typename Dispatch::InputType, Input::Type::Double>::value, typename Dispatch::ReadType>::type
+read_array_item(const Address &a, unsigned int idx, const typename Dispatch::InputType &) {
+    return a.storage_head()->get_item(idx)->get_double();
+}
+
+
 
 
 } // closing namespace internal
@@ -227,11 +227,7 @@ inline Iterator<T> & Iterator<T>::operator --() {
 template<class T>
 inline typename Iterator<T>::OutputType Iterator<T>::operator *() const {
 
-    auto new_address =address_.down(index_);
-
-    ASSERT_PTR(new_address->storage_head()).error();
-
-    return internal::TypeDispatch < DispatchType > ::value(*new_address, type_);
+    return internal::read_array_item< internal::TypeDispatch<DispatchType> >(address_, index_, type_);
 }
 
 template<class T>
@@ -17,71 +17,249 @@
 
 #include "input/csv_tokenizer.hh"
 #include "input/reader_internal_base.hh"
-#include <boost/lexical_cast.hpp>
+#include "system/file_path.hh"
+#include "system/logger.hh"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
 
-using namespace boost;
 using namespace Input;
 
 
+namespace {
+
+/**
+ * Zero terminated copy of a numeric token needed by strtol/strtod.
+ *
+ * Numeric tokens fit into the stack buffer, so no memory is allocated;
+ * only unusually long tokens are copied to a string.
+ */
+class NumericTokenCopy {
+public:
+    NumericTokenCopy(const char *begin, unsigned int size)
+    : size_(size)
+    {
+        if (size < sizeof(buf_)) {
+            std::memcpy(buf_, begin, size);
+            buf_[size] = 0;
+            str_ = buf_;
+        } else {
+            long_str_.assign(begin, size);
+            str_ = long_str_.c_str();
+        }
+    }
+
+    inline const char *c_str() const
+    { return str_; }
+
+    inline const char *end() const
+    { return str_ + size_; }
+
+private:
+    char buf_[64];
+    std::string long_str_;
+    const char *str_;
+    unsigned int size_;
+};
+
+} // namespace
+
+
 CSVTokenizer::CSVTokenizer(const FilePath &fp, std::string field_separator)
-: Tokenizer(fp, Tokenizer::Separator("\\", field_separator, "\""))
-{}
+: f_name_(fp)
+{
+    std::ifstream in;
+    fp.open_stream(in);
+    read_stream(in, field_separator);
+}
 
 
 
 CSVTokenizer::CSVTokenizer( std::istream &in, std::string field_separator)
-: Tokenizer(in, Tokenizer::Separator("\\", field_separator, "\""))
-{}
+: f_name_("__anonymous_stream__")
+{
+    read_stream(in, field_separator);
+}
 
 
-unsigned int CSVTokenizer::get_n_lines()
+void CSVTokenizer::read_stream(std::istream &in, const std::string &field_separator)
 {
-    unsigned int n_lines = 0; // number of lines
-    this->set_position( Tokenizer::Position() );
-    while ( !this->eof() ) {
-    	this->next_line(false);
-    	n_lines++;
+    std::memset(is_separator_, 0, sizeof(is_separator_));
+    for (unsigned char c : field_separator) is_separator_[c] = true;
+
+    // read the whole stream by one operation if its size is known
+    in.seekg(0, std::ios::end);
+    std::streamoff size = in.tellg();
+    if (size > 0) {
+        in.seekg(0, std::ios::beg);
+        buffer_.resize(size);
+        in.read(&buffer_[0], size);
+        buffer_.resize(in.gcount());
+    } else {
+        in.clear();
+        std::ostringstream ss;
+        ss << in.rdbuf();
+        buffer_ = ss.str();
+    }
+
+    // find non-empty lines, trim white spaces
+    std::size_t begin = 0;
+    unsigned int number = 0;
+    while (begin < buffer_.size()) {
+        const char *nl = static_cast<const char *>( std::memchr(&buffer_[begin], '\n', buffer_.size()-begin) );
+        std::size_t end = (nl == nullptr) ? buffer_.size() : nl - buffer_.data();
+        std::size_t next = end + 1;
+        number++;
+        while (begin < end && std::isspace( (unsigned char)buffer_[begin] )) begin++;
+        while (end > begin && std::isspace( (unsigned char)buffer_[end-1] )) end--;
+        if (end > begin) lines_.push_back( {begin, end, number} );
+        begin = next;
     }
-    if (this->line().size()==0) n_lines--; // removes last line if it is empty
-	return n_lines;
+
+    next_line_idx_ = 0;
+    line_num_ = 0;
+    tok_idx_ = 0;
+    n_line_positions_ = 0;
+}
+
+
+unsigned int CSVTokenizer::get_n_lines()
+{
+	return lines_.size();
 }
 
 
 void CSVTokenizer::skip_header(unsigned int n_head_lines)
 {
-    this->set_position( Tokenizer::Position() );
-    for (unsigned int i=0; i<n_head_lines; i++) {
-    	this->next_line(false);
+    next_line_idx_ = std::min( (std::size_t)n_head_lines, lines_.size() );
+    line_num_ = (next_line_idx_ > 0) ? lines_[next_line_idx_-1].number : 0;
+    tokens_.clear();
+    unescaped_.clear();
+    tok_idx_ = 0;
+}
+
+
+bool CSVTokenizer::next_line(bool assert_for_remaining_tokens)
+{
+    if (assert_for_remaining_tokens && (! eol() )) {
+        WarningOut().fmt( "Remaining token '{}', file '{}', line {} after token #{}\n",
+                get_string_val(), f_name_, line_num(), pos());
     }
+
+    tokens_.clear();
+    unescaped_.clear();
+    tok_idx_ = 0;
+    n_line_positions_ = 0;
+    if (next_line_idx_ >= lines_.size()) return false;
+
+    tokenize_line(next_line_idx_);
+    line_num_ = lines_[next_line_idx_].number;
+    next_line_idx_++;
+    return true;
+}
+
+
+void CSVTokenizer::tokenize_line(unsigned int line_idx)
+{
+    const char *p = buffer_.data() + lines_[line_idx].begin;
+    const char *end = buffer_.data() + lines_[line_idx].end;
+    unsigned int position = 0;
+
+    while (true) {
+        const char *tok_begin = p;
+        // plain token refers directly to the buffer
+        while (p != end && *p != '"' && *p != '\\' && !is_separator_[(unsigned char)*p]) ++p;
+
+        if (p == end || is_separator_[(unsigned char)*p]) {
+            if (p != tok_begin) tokens_.push_back( {tok_begin, (unsigned int)(p-tok_begin), position} );
+        } else {
+            // token with quotes or escapes is unescaped into auxiliary storage
+            std::string text(tok_begin, p);
+            bool in_quote = false;
+            for (; p != end; ++p) {
+                if (*p == '\\') {
+                    if (++p == end) break;
+                    text += (*p == 'n') ? '\n' : *p;
+                } else if (*p == '"') {
+                    in_quote = !in_quote;
+                } else if (!in_quote && is_separator_[(unsigned char)*p]) {
+                    break;
+                } else {
+                    text += *p;
+                }
+            }
+            if (text.size()) {
+                unescaped_.push_back(text);
+                tokens_.push_back( {unescaped_.back().data(), (unsigned int)text.size(), position} );
+            }
+        }
+
+        position++;
+        if (p == end) break;
+        ++p; // skip separator
+    }
+    n_line_positions_ = position;
+}
+
+
+const CSVTokenizer::Token &CSVTokenizer::token() const
+{
+    if ( eol() ) {
+        THROW( ReaderInternalBase::ExcWrongCsvFormat() << ReaderInternalBase::EI_Specification("Missing token")
+                << ReaderInternalBase::EI_TokenizerMsg(this->position_msg()) );
+    }
+    return tokens_[tok_idx_];
+}
+
+
+std::string CSVTokenizer::position_msg() const
+{
+    std::stringstream ss;
+    ss << "token: " << pos() << ", line: " << line_num() << ", in file '" << f_name() << "'";
+    return ss.str();
 }
 
 
 int CSVTokenizer::get_int_val()
 {
-	try {
-		return lexical_cast<int>( *(*this) );
-	} catch (bad_lexical_cast &) {
+    const Token &t = token();
+    NumericTokenCopy str(t.begin, t.size);
+    char *str_end;
+    errno = 0;
+    long val = std::strtol(str.c_str(), &str_end, 10);
+    if ( str_end != str.end() || std::isspace((unsigned char)str.c_str()[0]) || errno == ERANGE
+            || val < INT_MIN || val > INT_MAX ) {
 		THROW( ReaderInternalBase::ExcWrongCsvFormat() << ReaderInternalBase::EI_TokenizerMsg(this->position_msg()) );
 	}
+    return val;
 }
 
 
 double CSVTokenizer::get_double_val()
 {
-	try {
-		return lexical_cast<double>( *(*this) );
-	} catch (bad_lexical_cast &) {
+    const Token &t = token();
+    NumericTokenCopy str(t.begin, t.size);
+    char *str_end;
+    errno = 0;
+    double val = std::strtod(str.c_str(), &str_end);
+    if ( str_end != str.end() || std::isspace((unsigned char)str.c_str()[0])
+            || (errno == ERANGE && std::fabs(val) == HUGE_VAL) ) {
 		THROW( ReaderInternalBase::ExcWrongCsvFormat() << ReaderInternalBase::EI_Specification("Wrong double value")
 				<< ReaderInternalBase::EI_TokenizerMsg(this->position_msg()) );
 	}
+    return val;
 }
 
 
 std::string CSVTokenizer::get_string_val()
 {
-	try {
-		return *(*this);
-	} catch (bad_lexical_cast &) {
-		THROW( ReaderInternalBase::ExcWrongCsvFormat() << ReaderInternalBase::EI_TokenizerMsg(this->position_msg()) );
-	}
+    const Token &t = token();
+    return std::string(t.begin, t.size);
 }
@@ -18,15 +18,26 @@
 #ifndef CSV_TOKENIZER_HH_
 #define CSV_TOKENIZER_HH_
 
-#include <system/tokenizer.hh>
+#include <deque>
+#include <istream>
+#include <string>
+#include <vector>
+
+class FilePath;
 
 /**
  * @brief Simple class for parsing CSV files.
  *
  * CSV tokenizer use backslash '\\' as the escape character, double quotas '"' as quotation
  * character, and comma ',' as the separator of tokens.
+ *
+ * The whole file is read into memory by one read operation and split into non-empty lines.
+ * Tokens of the current line refer directly to the buffer (only quoted or escaped tokens are
+ * copied) and numeric values are converted through a small stack copy of the token, without
+ * allocation of strings.
+ * Empty lines and empty tokens (consecutive separators) are skipped.
  */
-class CSVTokenizer : public Tokenizer {
+class CSVTokenizer {
 public:
     /**
      * Opens a file given by file path @p fp. And construct the CSV tokenizer over the
@@ -42,7 +53,7 @@ public:
      */
 	CSVTokenizer(std::istream &in, std::string field_separator = ",");
 
-	/// Get count of lines in CSV file.
+	/// Get count of (non-empty) lines in CSV file.
 	unsigned int get_n_lines();
 
 	/**
@@ -52,6 +63,40 @@ public:
 	 */
 	void skip_header(unsigned int n_head_lines);
 
+    /**
+     * Drops remaining tokens on the current line and reads the next non-empty line.
+     * Returns false if we reach the end of file otherwise returns true.
+     *
+     * If @p assert_for_remaining_tokens is true, a warning is printed for remaining tokens.
+     */
+    bool next_line(bool assert_for_remaining_tokens=true);
+
+    /// Moves to the next token on the line.
+    inline CSVTokenizer &operator ++()
+    {
+        if (! eol()) tok_idx_++;
+        return *this;
+    }
+
+    /// Returns true if the iterator is over the last token on the current line.
+    inline bool eol() const
+        { return tok_idx_ >= tokens_.size(); }
+
+    /// Returns position of the current token on line (empty tokens are counted).
+    inline unsigned int pos() const
+        { return eol() ? n_line_positions_ : tokens_[tok_idx_].position; }
+
+    /// Returns number of the current line in the file.
+    inline unsigned int line_num() const
+        { return line_num_; }
+
+    /// Returns file name.
+    inline const std::string &f_name() const
+        { return f_name_; }
+
+    /// Returns full position description.
+    std::string position_msg() const;
+
 	/// Cast token on actual position to integer value and return its.
 	int get_int_val();
 
@@ -60,6 +105,51 @@ public:
 
 	/// Return string value of token on actual position.
 	std::string get_string_val();
+
+private:
+    /// Token of the current line.
+    struct Token {
+        const char *begin;      ///< Start of the token text (in buffer_ or unescaped_).
+        unsigned int size;      ///< Length of the token text.
+        unsigned int position;  ///< Position of the token on the line.
+    };
+
+    /// Non-empty line of the file.
+    struct Line {
+        std::size_t begin;      ///< Offset of the first character (after trimming).
+        std::size_t end;        ///< Offset after the last character (after trimming).
+        unsigned int number;    ///< Line number in the file, counted from 1.
+    };
+
+    /// Read whole stream into buffer_ and find non-empty lines.
+    void read_stream(std::istream &in, const std::string &field_separator);
+
+    /// Split the line @p line_idx into tokens.
+    void tokenize_line(unsigned int line_idx);
+
+    /// Return current token, throws if there is none.
+    const Token &token() const;
+
+    /// File name (for better error messages).
+    std::string f_name_;
+    /// Table of separator characters.
+    bool is_separator_[256];
+    /// Content of the file.
+    std::string buffer_;
+    /// Non-empty lines of the file.
+    std::vector<Line> lines_;
+    /// Index of the next line to read in lines_.
+    unsigned int next_line_idx_;
+    /// Number of the current line in the file.
+    unsigned int line_num_;
+    /// Tokens of the current line.
+    std::vector<Token> tokens_;
+    /// Texts of tokens containing quotes or escapes of the current line.
+    std::deque<std::string> unescaped_;
+    /// Index of the current token.
+    unsigned int tok_idx_;
+    /// Number of positions (including empty tokens) on the current line.
+    unsigned int n_line_positions_;
 };
 
 #endif /* CSV_TOKENIZER_HH_ */
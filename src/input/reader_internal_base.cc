@@ -305,11 +305,14 @@ StorageBase * ReaderInternalBase::make_array_storage(PathBase &p, const Type::Ar
 	ASSERT(p.is_array_type()).error();
 
     if ( array->match_size( arr_size ) ) {
+      const Type::TypeBase &sub_type = array->get_sub_type();
+      if (typeid(sub_type) == typeid(Type::Double))
+          return make_double_array_storage(p, &sub_type, arr_size);
+
       // copy the array and check type of values
       StorageArray *storage_array = new StorageArray(arr_size);
       for( int idx=0; idx < arr_size; idx++)  {
           p.down(idx);
-          const Type::TypeBase &sub_type = array->get_sub_type();
           storage_array->new_item(idx, make_storage(p, &sub_type) );
           p.up();
       }
@@ -324,6 +327,32 @@ StorageBase * ReaderInternalBase::make_array_storage(PathBase &p, const Type::Ar
 	return NULL; // suppress warning for non-void function
 }
 
+StorageBase * ReaderInternalBase::make_double_array_storage(PathBase &p, const Type::TypeBase *sub_type, int arr_size)
+{
+    std::vector<double> values(arr_size);
+    StorageArray *storage_array = nullptr;
+    for( int idx=0; idx < arr_size; idx++)  {
+        p.down(idx);
+        StorageBase *item = make_storage(p, sub_type);
+        p.up();
+
+        if (storage_array == nullptr && typeid(*item) != typeid(StorageDouble)) {
+            // null or transposed items can not be stored in the compact array, fall back to general array
+            storage_array = new StorageArray(arr_size);
+            for (int i=0; i<idx; i++) storage_array->new_item(i, new StorageDouble(values[i]) );
+        }
+        if (storage_array != nullptr) {
+            storage_array->new_item(idx, item);
+        } else {
+            values[idx] = item->get_double();
+            delete item;
+        }
+    }
+
+    if (storage_array != nullptr) return storage_array;
+    return new StorageDoubleArray(values);
+}
+
 StorageBase * ReaderInternalBase::make_storage_from_default(const string &dflt_str, std::shared_ptr<Type::TypeBase> type) {
     try {
     	// default strings must be valid JSON
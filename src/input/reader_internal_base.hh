@@ -118,6 +118,9 @@ protected:
     /// Create storage of Type::Array with given size
     StorageBase * make_array_storage(PathBase &p, const Type::Array *array, int arr_size);
 
+    /// Create compact storage of array of Type::Double values, used by make_array_storage.
+    StorageBase * make_double_array_storage(PathBase &p, const Type::TypeBase *sub_type, int arr_size);
+
     /// Dispatch according to @p type and create corresponding storage from the given string.
     StorageBase * make_storage_from_default( const string &dflt_str, std::shared_ptr<Type::TypeBase> type);
 
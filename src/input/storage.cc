@@ -256,6 +256,65 @@ StorageDouble::~StorageDouble()
 
 
 
+/**********************************************
+ * Implementation of StorageDoubleArray
+ */
+
+StorageDoubleArray::StorageDoubleArray(const std::vector<double> &values)
+{
+    array_.reserve(values.size());
+    for (double value : values) array_.emplace_back(value);
+}
+
+
+
+void StorageDoubleArray::set_item(unsigned int index, StorageBase* item) {
+	ASSERT_LT(index, array_.size()).error("Index is out of array.");
+	ASSERT_PTR(item).error();
+
+    array_[index] = StorageDouble( item->get_double() );
+    delete item;
+}
+
+
+
+StorageBase * StorageDoubleArray::get_item(const unsigned int index) const {
+	ASSERT_LT(index, array_.size()).error("Index is out of array.");
+    return const_cast<StorageDouble *>( &array_[index] );
+}
+
+
+
+unsigned int StorageDoubleArray::get_array_size() const {
+    return array_.size();
+}
+
+
+
+bool StorageDoubleArray::is_null() const {
+    return false;
+}
+
+
+
+StorageBase * StorageDoubleArray::deep_copy() const {
+    return new StorageDoubleArray(*this);
+}
+
+
+
+void StorageDoubleArray::print(ostream &stream, int pad)  const {
+    stream << setw(pad) << "" << "array(" << this->get_array_size() << ")" << std::endl;
+    for(unsigned int i=0;i<get_array_size();++i) array_[i].print(stream, pad+2);
+}
+
+
+
+StorageDoubleArray::~StorageDoubleArray()
+{}
+
+
+
 /**********************************************
  * Implementation of StorageString
  */
@@ -56,7 +56,7 @@ DECLARE_EXCEPTION(ExcStorageTypeMismatch, << "Storage type mismatch. You want va
  * This class as well as its descendants is meant for internal usage only as part of the implementation of the input interface.
  *
  * The leave nodes of the data storage tree can be of types \p StorageBool, \p StorageInt, \p StorageDouble, and StorageNull.
- * The branching nodes of the tree are of type StorageArray. The data storage tree serves to store data with structure described
+ * The branching nodes of the tree are of type StorageArray, arrays of doubles can be stored in compact StorageDoubleArray. The data storage tree serves to store data with structure described
  * by Input::Type classes. Therefore it provides no way to ask for the type of stored data and an exception \p ExcStorageTypeMismatch
  * is thrown if you use
  * getter that do not match actual type of the node. Moreover, the tree can be only created using bottom-up approach and than can
@@ -144,6 +144,30 @@ private:
     double value_;
 };
 
+/**
+ * Array of double values stored contiguously.
+ *
+ * Arrays of Type::Double are the most voluminous part of the input (time tables, observation points, ...).
+ * Compared to StorageArray, the items are not allocated separately on the heap, so the memory overhead
+ * is one virtual table pointer per value. The items are still StorageDouble nodes, so that all accessors
+ * working with StorageArray work without change.
+ */
+class StorageDoubleArray : public StorageBase {
+public:
+    StorageDoubleArray(const std::vector<double> &values);
+    /// Replace value of the item by value of the given StorageDouble @p item, which is deleted.
+    virtual void set_item(unsigned int index, StorageBase* item);
+    virtual StorageBase * get_item(const unsigned int index) const;
+    virtual unsigned int get_array_size() const;
+    virtual bool is_null() const;
+    virtual StorageBase *deep_copy() const;
+    virtual void print(std::ostream &stream, int pad=0) const;
+    virtual ~StorageDoubleArray();
+private:
+    std::vector<StorageDouble> array_;
+};
+
+
 class StorageString : public StorageBase {
 public:
     StorageString(const std::string & value);
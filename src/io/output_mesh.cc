@@ -362,9 +362,7 @@ OutputMeshDiscontinuous::~OutputMeshDiscontinuous()
 
 
 template<int dim>
-void OutputMeshDiscontinuous::refine_aux_element(const OutputMeshDiscontinuous::AuxElement& aux_element,
-                                                 std::vector< OutputMeshDiscontinuous::AuxElement >& refinement,
-                                                 const ElementAccessor<spacedim> &ele_acc)
+void OutputMeshDiscontinuous::split_simplex(const Space<spacedim>::Point *nodes, Space<spacedim>::Point *sub_nodes)
 {
     static const unsigned int n_subelements = 1 << dim;  //2^dim
     
@@ -440,72 +438,96 @@ void OutputMeshDiscontinuous::refine_aux_element(const OutputMeshDiscontinuous::
          6, 5, 7, 4,
          5, 6, 7, 9}
     };
-//     DBGMSG("level = %d, %d\n", aux_element.level, max_refinement_level_);
- 
-    ASSERT_DBG(dim == aux_element.nodes.size()-1);
-    
-    // if not refining any further, push into final vector
-    if( ! refinement_criterion(aux_element, ele_acc) ) {
-        refinement.push_back(aux_element);
-        return;
-    }
-    
-    std::vector<AuxElement> subelements(n_subelements);
-    
     const unsigned int n_old_nodes = RefElement<dim>::n_nodes,
                        n_new_nodes = RefElement<dim>::n_lines; // new points are in the center of lines
-    
-    // auxiliary vectors
-    std::vector<Space<spacedim>::Point> nodes = aux_element.nodes;
-    
-    nodes.reserve(n_old_nodes+n_new_nodes);
 
-    // create new points in the element
+    // original nodes followed by the midpoints of lines
+    Space<spacedim>::Point aux_nodes[n_old_nodes+n_new_nodes];
+    for(unsigned int i=0; i < n_old_nodes; i++) aux_nodes[i] = nodes[i];
     for(unsigned int e=0; e < n_new_nodes; e++)
     {
-        Space<spacedim>::Point p = nodes[RefElement<dim>::interact(Interaction<0,1>(e))[0]]
-                                  +nodes[RefElement<dim>::interact(Interaction<0,1>(e))[1]];
-        nodes.push_back( p / 2.0);
-        //nodes.back().print();
+        aux_nodes[n_old_nodes+e] = ( nodes[RefElement<dim>::interact(Interaction<0,1>(e))[0]]
+                                    +nodes[RefElement<dim>::interact(Interaction<0,1>(e))[1]] ) / 2.0;
     }
-    
+
     unsigned int diagonal = 0;
     // find shortest diagonal: [0]:4-9, [1]:5-8 or [2]:6-7
     if(dim == 3){
-        double min_diagonal = arma::norm(nodes[4]-nodes[9],2);
-        double d = arma::norm(nodes[5]-nodes[8],2);
+        double min_diagonal = arma::norm(aux_nodes[4]-aux_nodes[9],2);
+        double d = arma::norm(aux_nodes[5]-aux_nodes[8],2);
         if(d < min_diagonal){
             min_diagonal = d;
             diagonal = 1;
         }
-        d = arma::norm(nodes[6]-nodes[7],2);
+        d = arma::norm(aux_nodes[6]-aux_nodes[7],2);
         if(d < min_diagonal){
             min_diagonal = d;
             diagonal = 2;
         }
     }
+
+    for(unsigned int conn_id=0; conn_id < n_subelements*n_old_nodes; conn_id++)
+        sub_nodes[conn_id] = aux_nodes[conn[dim+diagonal][conn_id]];
+}
+
+
+template<int dim>
+void OutputMeshDiscontinuous::refine_aux_element(const OutputMeshDiscontinuous::AuxElement& aux_element,
+                                                 std::vector< OutputMeshDiscontinuous::AuxElement >& refinement,
+                                                 const ElementAccessor<spacedim> &ele_acc)
+{
+    static const unsigned int n_subelements = 1 << dim;  //2^dim
+    const unsigned int n_old_nodes = RefElement<dim>::n_nodes;
+
+    ASSERT_DBG(dim == aux_element.nodes.size()-1);
+    
+    // if not refining any further, push into final vector
+    if( ! refinement_criterion(aux_element, ele_acc) ) {
+        refinement.push_back(aux_element);
+        return;
+    }
     
+    Space<spacedim>::Point sub_nodes[n_subelements*n_old_nodes];
+    split_simplex<dim>(&aux_element.nodes[0], sub_nodes);
+
+    AuxElement sub_ele;
+    sub_ele.nodes.resize(n_old_nodes);
+    sub_ele.level = aux_element.level+1;
     for(unsigned int i=0; i < n_subelements; i++)
     {
-        AuxElement& sub_ele = subelements[i];
-        sub_ele.nodes.resize(n_old_nodes);
-        sub_ele.level = aux_element.level+1;
-        
-        // over nodes
         for(unsigned int j=0; j < n_old_nodes; j++)
-        {
-            unsigned int conn_id = (n_old_nodes)*i + j;
-            sub_ele.nodes[j] = nodes[conn[dim+diagonal][conn_id]];
-        }
+            sub_ele.nodes[j] = sub_nodes[n_old_nodes*i + j];
         refine_aux_element<dim>(sub_ele, refinement, ele_acc);
     }
 }
 
 
+template<int dim>
+void OutputMeshDiscontinuous::refine_uniform(std::vector<Space<spacedim>::Point> &ref_nodes,
+                                             std::vector<Space<spacedim>::Point> &tmp_nodes)
+{
+    static const unsigned int n_subelements = 1 << dim;  //2^dim
+    const unsigned int n_old_nodes = RefElement<dim>::n_nodes;
+
+    // on input ref_nodes holds nodes of the original element
+    for(unsigned int level=0; level < max_level_; level++)
+    {
+        const unsigned int n_elems = ref_nodes.size() / n_old_nodes;
+        tmp_nodes.resize(n_elems * n_subelements * n_old_nodes);
+        for(unsigned int i=0; i < n_elems; i++)
+            split_simplex<dim>(&ref_nodes[i*n_old_nodes], &tmp_nodes[i*n_subelements*n_old_nodes]);
+        ref_nodes.swap(tmp_nodes);
+    }
+}
+
+
 
 template void OutputMeshDiscontinuous::refine_aux_element<1>(const OutputMeshDiscontinuous::AuxElement&,std::vector< OutputMeshDiscontinuous::AuxElement >&, const ElementAccessor<spacedim> &);
 template void OutputMeshDiscontinuous::refine_aux_element<2>(const OutputMeshDiscontinuous::AuxElement&,std::vector< OutputMeshDiscontinuous::AuxElement >&, const ElementAccessor<spacedim> &);
 template void OutputMeshDiscontinuous::refine_aux_element<3>(const OutputMeshDiscontinuous::AuxElement&,std::vector< OutputMeshDiscontinuous::AuxElement >&, const ElementAccessor<spacedim> &);
+template void OutputMeshDiscontinuous::refine_uniform<1>(std::vector<Space<spacedim>::Point> &, std::vector<Space<spacedim>::Point> &);
+template void OutputMeshDiscontinuous::refine_uniform<2>(std::vector<Space<spacedim>::Point> &, std::vector<Space<spacedim>::Point> &);
+template void OutputMeshDiscontinuous::refine_uniform<3>(std::vector<Space<spacedim>::Point> &, std::vector<Space<spacedim>::Point> &);
 
 
 bool OutputMeshDiscontinuous::refinement_criterion(const AuxElement& aux_ele,
@@ -635,60 +657,83 @@ void OutputMeshDiscontinuous::create_refined_sub_mesh()
     auto &conn_vec = *( connectivity_->get_component_data(0).get() );
     auto &offset_vec = *( offsets_->get_component_data(0).get() );
 
-    node_vec.reserve(4*orig_mesh_->n_nodes());
-    conn_vec.reserve(4*4*orig_mesh_->n_elements());
-    offset_vec.reserve(4*orig_mesh_->n_elements());
-
     LongIdx *el_4_loc = orig_mesh_->get_el_4_loc();
     const unsigned int n_local_elements = orig_mesh_->get_el_ds()->lsize();
 
+    if (refine_by_error_) {
+        node_vec.reserve(4*orig_mesh_->n_nodes());
+        conn_vec.reserve(4*4*orig_mesh_->n_elements());
+        offset_vec.reserve(4*orig_mesh_->n_elements());
+    } else {
+        // uniform refinement, the final size is known in advance
+        unsigned int n_sub_elements = 0, n_sub_nodes = 0;
+        for (unsigned int loc_el = 0; loc_el < n_local_elements; loc_el++) {
+            const unsigned int dim = orig_mesh_->element_accessor( el_4_loc[loc_el] )->dim();
+            const unsigned int n_sub = 1 << (dim*max_level_);
+            n_sub_elements += n_sub;
+            n_sub_nodes += n_sub * (dim+1);
+        }
+        node_vec.reserve(n_sub_nodes*spacedim);
+        conn_vec.reserve(n_sub_nodes);
+        offset_vec.reserve(n_sub_elements);
+        orig_element_indices_->reserve(n_sub_elements);
+    }
+
+    // work buffers of uniform refinement, reused over elements
+    std::vector<Space<spacedim>::Point> ref_nodes, tmp_nodes;
+    std::vector<AuxElement> refinement;
+
     for (unsigned int loc_el = 0; loc_el < n_local_elements; loc_el++) {
     	auto ele = orig_mesh_->element_accessor( el_4_loc[loc_el] );
     	const unsigned int
             dim = ele->dim(),
             ele_idx = ele.idx();
 
-        AuxElement aux_ele;
-        aux_ele.nodes.resize(ele->n_nodes());
-        aux_ele.level = 0;
-
-        unsigned int li;
-        for (li=0; li<ele->n_nodes(); li++) {
-            aux_ele.nodes[li] = *ele.node(li);
+        ref_nodes.resize(ele->n_nodes());
+        for (unsigned int li=0; li<ele->n_nodes(); li++) {
+            ref_nodes[li] = *ele.node(li);
         }
 
-        std::vector<AuxElement> refinement;
+        if (refine_by_error_) {
+            AuxElement aux_ele;
+            aux_ele.nodes = ref_nodes;
+            aux_ele.level = 0;
+
+            refinement.clear();
+            switch(dim){
+                case 1: this->refine_aux_element<1>(aux_ele, refinement, ele); break;
+                case 2: this->refine_aux_element<2>(aux_ele, refinement, ele); break;
+                case 3: this->refine_aux_element<3>(aux_ele, refinement, ele); break;
+                default: ASSERT(0 < dim && dim < 4);
+            }
 
-        switch(dim){
-            case 1: this->refine_aux_element<1>(aux_ele, refinement, ele); break;
-            case 2: this->refine_aux_element<2>(aux_ele, refinement, ele); break;
-            case 3: this->refine_aux_element<3>(aux_ele, refinement, ele); break;
-            default: ASSERT(0 < dim && dim < 4);
+            // store nodes of subelements continuously
+            ref_nodes.clear();
+            for (auto &sub_ele : refinement)
+                ref_nodes.insert(ref_nodes.end(), sub_ele.nodes.begin(), sub_ele.nodes.end());
+        } else {
+            switch(dim){
+                case 1: this->refine_uniform<1>(ref_nodes, tmp_nodes); break;
+                case 2: this->refine_uniform<2>(ref_nodes, tmp_nodes); break;
+                case 3: this->refine_uniform<3>(ref_nodes, tmp_nodes); break;
+                default: ASSERT(0 < dim && dim < 4);
+            }
         }
 
-        //skip unrefined element
-//         if(refinement.size() < 2) continue;
-        unsigned int node_offset = node_vec.size(),
-                     con_offset = conn_vec.size();
-        node_vec.resize(node_vec.size() + (refinement.size() * (dim+1))*spacedim);
-        conn_vec.resize(conn_vec.size() + refinement.size()*(dim+1));
-//         orig_element_indices_->resize(orig_element_indices_->size() + refinement.size()*(dim+1));
-
-//         DebugOut() << "ref size = " << refinement.size() << "\n";
         //gather coords and connectivity (in a continous way inside element)
-        for(unsigned int i=0; i < refinement.size(); i++)
+        const unsigned int n_sub_elements = ref_nodes.size() / (dim+1);
+        unsigned int con_offset = conn_vec.size();
+        for(unsigned int i=0; i < n_sub_elements; i++)
         {
             last_offset += dim+1;
             offset_vec.push_back(last_offset);
             (*orig_element_indices_).push_back(ele_idx);
-            for(unsigned int j=0; j < dim+1; j++)
-            {
-                unsigned int con = i*(dim+1) + j;
-                conn_vec[con_offset + con] = con_offset + con;
-
-                for(unsigned int k=0; k < spacedim; k++) {
-                    node_vec[node_offset + con*spacedim + k] = refinement[i].nodes[j][k];
-                }
+        }
+        for(unsigned int con=0; con < ref_nodes.size(); con++)
+        {
+            conn_vec.push_back(con_offset + con);
+            for(unsigned int k=0; k < spacedim; k++) {
+                node_vec.push_back(ref_nodes[con][k]);
             }
         }
     }
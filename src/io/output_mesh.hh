@@ -280,6 +280,23 @@ protected:
         unsigned int level;
     };
 
+    /**
+     * Splits simplex given by @p nodes into 2^dim subsimplices (red refinement).
+     * Nodes of subelements are stored consecutively to @p sub_nodes, which must
+     * have space for 2^dim * (dim+1) points.
+     */
+    template<int dim>
+    static void split_simplex(const Space<spacedim>::Point *nodes, Space<spacedim>::Point *sub_nodes);
+
+    /**
+     * Uniform refinement of single element up to @p max_level_, without evaluation of refinement criteria.
+     * On input @p ref_nodes contains nodes of original element, on output nodes of all subelements.
+     * @p tmp_nodes is a work buffer, both vectors can be reused over elements to avoid reallocations.
+     */
+    template<int dim>
+    void refine_uniform(std::vector<Space<spacedim>::Point> &ref_nodes,
+                        std::vector<Space<spacedim>::Point> &tmp_nodes);
+
     ///Performs the actual refinement of AuxElement. Recurrent.
     template<int dim>
     void refine_aux_element(const AuxElement& aux_element,
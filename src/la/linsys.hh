@@ -319,6 +319,20 @@ public:
         ierr = VecCreateMPIWithArray( comm_,1, rows_ds_->lsize(), PETSC_DECIDE, v_solution_, &solution_ ); CHKERRV( ierr );
     }
 
+    /**
+     * Set vectors spanning the near null space of the matrix, e.g. rigid body modes of elasticity.
+     * Used by algebraic multigrid preconditioners, ignored by default.
+     */
+    virtual void set_near_nullspace(const std::vector<Vec> &)
+    {}
+
+    /**
+     * Set coordinates of locally owned rows, given number of values (space dimension) per row.
+     * Used by algebraic multigrid preconditioners, ignored by default.
+     */
+    virtual void set_coordinates(unsigned int, const std::vector<double> &)
+    {}
+
     /**
      *  Returns PETSC subarray with solution. Underlying array can be provided on construction.
      */
@@ -22,6 +22,7 @@
 #include "petscksp.h"
 #include "petscmat.h"
 #include "system/sys_profiler.hh"
+#include "system/asserts.hh"
 #include "system/system.hh"
 
 
@@ -51,6 +52,13 @@ const it::Record & LinSys_PETSC::get_input_type() {
                     "Maximum number of outer iterations of the linear solver.")
 		.declare_key("options", it::String(), it::Default("\"\""),  "This options is passed to PETSC to create a particular KSP (Krylov space method).\n"
                                                                     "If the string is left empty (by default), the internal default options is used.")
+		.declare_key("pc_lag", it::Integer(0), it::Default("0"),
+		            "Number of subsequent solves in which the preconditioner is reused although the matrix has changed. "
+		            "For zero value the preconditioner is rebuilt whenever the matrix changes. "
+		            "The preconditioner is always reused if the matrix is not changed.")
+		.declare_key("pc_rebuild_factor", it::Double(1.0), it::Default("2.0"),
+		            "A lagged preconditioner is rebuilt if the number of iterations exceeds "
+		            "the number of iterations of the first solve with this preconditioner multiplied by this factor.")
 		.close();
 }
 
@@ -62,7 +70,15 @@ LinSys_PETSC::LinSys_PETSC( const Distribution * rows_ds, const std::string &par
         : LinSys( rows_ds ),
           params_(params),
           init_guess_nonzero(false),
-          matrix_(0)
+          matrix_(0),
+          system(NULL),
+          pc_lag_(0),
+          pc_rebuild_factor_(2.0),
+          pc_matrix_(NULL),
+          n_lagged_solves_(0),
+          pc_setup_its_(0),
+          near_null_space_(NULL),
+          coords_dim_(0)
 {
     // create PETSC vectors:
     PetscErrorCode ierr;
@@ -79,7 +95,10 @@ LinSys_PETSC::LinSys_PETSC( const Distribution * rows_ds, const std::string &par
 }
 
 LinSys_PETSC::LinSys_PETSC( LinSys_PETSC &other )
-	: LinSys(other), params_(other.params_), v_rhs_(NULL), solution_precision_(other.solution_precision_)
+	: LinSys(other), params_(other.params_), v_rhs_(NULL), solution_precision_(other.solution_precision_),
+	  system(NULL), pc_lag_(other.pc_lag_), pc_rebuild_factor_(other.pc_rebuild_factor_),
+	  pc_matrix_(NULL), n_lagged_solves_(0), pc_setup_its_(0), near_null_space_(NULL),
+	  coords_dim_(other.coords_dim_), coords_(other.coords_)
 {
 	MatCopy(other.matrix_, matrix_, DIFFERENT_NONZERO_PATTERN);
 	VecCopy(other.rhs_, rhs_);
@@ -100,6 +119,8 @@ void LinSys_PETSC::set_tolerances(double  r_tol, double a_tol, unsigned int max_
         max_it_ = max_it;
 
     }
+    // tolerances of already created KSP must be updated
+    if (system != NULL) chkerr(KSPSetTolerances(system, r_tol_, a_tol_, PETSC_DEFAULT,  max_it_));
 }
 
 
@@ -260,6 +281,7 @@ void LinSys_PETSC::finish_assembly( MatAssemblyType assembly_type )
     if (status_ == ALLOCATE) {
     	WarningOut() << "Finalizing linear system without setting values.\n";
         this->preallocate_matrix();
+        matrix_changed_ = true;
     }
     ierr = MatAssemblyBegin(matrix_, assembly_type); CHKERRV( ierr ); 
     ierr = VecAssemblyBegin(rhs_); CHKERRV( ierr ); 
@@ -273,7 +295,8 @@ void LinSys_PETSC::finish_assembly( MatAssemblyType assembly_type )
     //VecView(rhs_, PETSC_VIEWER_STDOUT_SELF);
     //this->view();
 
-    matrix_changed_ = true;
+    // Matrix changes are tracked by mat_set_values, mat_zero_entries etc.,
+    // so that assembly of rhs alone keeps the preconditioner of an unchanged matrix.
     rhs_changed_ = true;
 }
 
@@ -361,46 +384,96 @@ LinSys::SolveInfo LinSys_PETSC::solve()
            petsc_dflt_opt="-ksp_type bcgs -pc_type ilu -pc_factor_levels 5 -ksp_diagonal_scale -ksp_diagonal_scale_fix -pc_factor_fill 6.0";
     }
 
-    if (params_ == "") params_ = petsc_dflt_opt;
-    LogOut().fmt("inserting petsc options: {}\n",params_.c_str());
-    
-    // now takes an optional PetscOptions object as the first argument
-    // value NULL will preserve previous behaviour previous behavior.
-    PetscOptionsInsertString(NULL, params_.c_str()); // overwrites previous options values
-    
     MatSetOption( matrix_, MAT_USE_INODES, PETSC_FALSE );
-    
-    chkerr(KSPCreate( comm_, &system ));
-    chkerr(KSPSetOperators(system, matrix_, matrix_));
 
+    // The KSP object is persistent, options are processed only at its creation.
+    if (system == NULL) {
+        if (params_ == "") params_ = petsc_dflt_opt;
+        LogOut().fmt("inserting petsc options: {}\n",params_.c_str());
+
+        // now takes an optional PetscOptions object as the first argument
+        // value NULL will preserve previous behaviour previous behavior.
+        PetscOptionsInsertString(NULL, params_.c_str()); // overwrites previous options values
+
+        chkerr(KSPCreate( comm_, &system ));
+        chkerr(KSPSetOperators(system, matrix_, matrix_));
+
+        // TODO take care of tolerances - shall we support both input file and command line petsc setting
+        chkerr(KSPSetTolerances(system, r_tol_, a_tol_, PETSC_DEFAULT,  max_it_));
+        KSPSetFromOptions(system);
+    }
+
+    // Preconditioner is reused if it was built for the same matrix object that has not changed since,
+    // or if the matrix has changed but the preconditioner can be lagged.
+    bool reuse_pc = (pc_matrix_ == matrix_) && (!matrix_changed_ || n_lagged_solves_ < pc_lag_);
+
+    if (near_null_space_ != NULL) chkerr(MatSetNearNullSpace(matrix_, near_null_space_));
+    chkerr(KSPSetOperators(system, matrix_, matrix_));
+    chkerr(KSPSetReusePreconditioner(system, reuse_pc ? PETSC_TRUE : PETSC_FALSE));
+    if (!reuse_pc && coords_dim_ > 0) {
+        PC pc;
+        chkerr(KSPGetPC(system, &pc));
+        chkerr(PCSetCoordinates(pc, coords_dim_, rows_ds_->lsize(), coords_.data()));
+    }
 
-    // TODO take care of tolerances - shall we support both input file and command line petsc setting
-    chkerr(KSPSetTolerances(system, r_tol_, a_tol_, PETSC_DEFAULT,PETSC_DEFAULT));
-    chkerr(KSPSetTolerances(system, r_tol_, a_tol_, PETSC_DEFAULT,  max_it_));
-    KSPSetFromOptions(system);
     // We set the KSP flag set_initial_guess_nonzero
     // unless KSP type is preonly.
     // In such case PETSc fails (version 3.4.1)
-    if (init_guess_nonzero)
     {
     	KSPType type;
     	KSPGetType(system, &type);
     	if (strcmp(type, KSPPREONLY) != 0)
-    		KSPSetInitialGuessNonzero(system, PETSC_TRUE);
+    		KSPSetInitialGuessNonzero(system, init_guess_nonzero ? PETSC_TRUE : PETSC_FALSE);
     }
 
     {
 		START_TIMER("PETSC linear solver");
-		START_TIMER("PETSC linear iteration");
-		chkerr(KSPSolve(system, rhs_, solution_ ));
-		KSPGetConvergedReason(system,&reason);
-		KSPGetIterationNumber(system,&nits);
-		ADD_CALLS(nits);
+		if (! reuse_pc) {
+		    START_TIMER("PETSC preconditioner setup");
+		    chkerr(KSPSetUp(system));
+		}
+		{
+		    START_TIMER("PETSC linear iteration");
+		    chkerr(KSPSolve(system, rhs_, solution_ ));
+		    KSPGetConvergedReason(system,&reason);
+		    KSPGetIterationNumber(system,&nits);
+		    ADD_CALLS(nits);
+		}
+
+		// lagged preconditioner failed, rebuild it and solve again
+		if (reuse_pc && reason < 0) {
+		    LogOut().fmt("convergence reason {} with lagged preconditioner, rebuilding preconditioner\n", reason);
+		    reuse_pc = false;
+		    chkerr(KSPSetReusePreconditioner(system, PETSC_FALSE));
+		    {
+		        START_TIMER("PETSC preconditioner setup");
+		        chkerr(KSPSetUp(system));
+		    }
+		    START_TIMER("PETSC linear iteration");
+		    chkerr(KSPSolve(system, rhs_, solution_ ));
+		    KSPGetConvergedReason(system,&reason);
+		    KSPGetIterationNumber(system,&nits);
+		    ADD_CALLS(nits);
+		}
+    }
+
+    // update state of the preconditioner reuse
+    if (reuse_pc) {
+        if (matrix_changed_) n_lagged_solves_++;
+        // too many iterations, enforce rebuild in the next solve
+        if (nits > pc_rebuild_factor_ * std::max(pc_setup_its_, 1)) n_lagged_solves_ = pc_lag_;
+    } else {
+        pc_matrix_ = matrix_;
+        pc_setup_its_ = nits;
+        n_lagged_solves_ = 0;
     }
+    matrix_changed_ = false;
+
     // substitute by PETSc call for residual
     VecNorm(rhs_, NORM_2, &residual_norm_);
     
-    LogOut().fmt("convergence reason {}, number of iterations is {}\n", reason, nits);
+    LogOut().fmt("convergence reason {}, number of iterations is {}{}\n", reason, nits,
+            (reuse_pc ? ", preconditioner reused" : ""));
 
     // get residual norm
     KSPGetResidualNorm(system, &solution_precision_);
@@ -408,8 +481,6 @@ LinSys::SolveInfo LinSys_PETSC::solve()
     // TODO: I do not understand this 
     //Profiler::instance()->set_timer_subframes("SOLVING MH SYSTEM", nits);
 
-    chkerr(KSPDestroy(&system));
-
     return LinSys::SolveInfo(static_cast<int>(reason), static_cast<int>(nits));
 
 }
@@ -440,8 +511,73 @@ void LinSys_PETSC::view( )
     }
 }
 
+LinSys::SolveInfo LinSys_PETSC::solve(Vec rhs, Vec solution)
+{
+    ASSERT_PTR(system).error("solve() has to be called before solving for additional right hand side.");
+    ASSERT(!matrix_changed_).error("Matrix has changed since the last solve().");
+    int nits;
+
+    chkerr(KSPSetReusePreconditioner(system, PETSC_TRUE));
+    {
+        START_TIMER("PETSC linear solver");
+        START_TIMER("PETSC linear iteration");
+        chkerr(KSPSolve(system, rhs, solution));
+        KSPGetConvergedReason(system,&reason);
+        KSPGetIterationNumber(system,&nits);
+        ADD_CALLS(nits);
+    }
+    LogOut().fmt("convergence reason {}, number of iterations is {}, shared preconditioner\n", reason, nits);
+
+    KSPGetResidualNorm(system, &solution_precision_);
+
+    return LinSys::SolveInfo(static_cast<int>(reason), static_cast<int>(nits));
+}
+
+
+void LinSys_PETSC::set_near_nullspace(const std::vector<Vec> &vectors)
+{
+    if (near_null_space_ != NULL) chkerr(MatNullSpaceDestroy(&near_null_space_));
+
+    // MatNullSpace requires orthonormal basis, use modified Gram-Schmidt
+    std::vector<Vec> basis;
+    for (Vec vec : vectors) {
+        Vec w;
+        PetscReal vec_norm, w_norm;
+        chkerr(VecNorm(vec, NORM_2, &vec_norm));
+        chkerr(VecDuplicate(vec, &w));
+        chkerr(VecCopy(vec, w));
+        for (Vec b : basis) {
+            PetscScalar dot;
+            chkerr(VecDot(w, b, &dot));
+            chkerr(VecAXPY(w, -dot, b));
+        }
+        chkerr(VecNormalize(w, &w_norm));
+        if (w_norm > 1.0e-10 * vec_norm) {
+            basis.push_back(w);
+        } else {
+            // e.g. rotations of a mesh lying on a line
+            chkerr(VecDestroy(&w));
+        }
+    }
+
+    chkerr(MatNullSpaceCreate(comm_, PETSC_FALSE, basis.size(), basis.data(), &near_null_space_));
+    // null space holds references to the vectors
+    for (Vec &b : basis) chkerr(VecDestroy(&b));
+}
+
+
+void LinSys_PETSC::set_coordinates(unsigned int dim, const std::vector<double> &coords)
+{
+    ASSERT_EQ(coords.size(), dim * rows_ds_->lsize()).error("Wrong size of coordinates.");
+    coords_dim_ = dim;
+    coords_.assign(coords.begin(), coords.end());
+}
+
+
 LinSys_PETSC::~LinSys_PETSC( )
 {
+    if (system != NULL) { chkerr(KSPDestroy(&system)); }
+    if (near_null_space_ != NULL) { chkerr(MatNullSpaceDestroy(&near_null_space_)); }
     if (matrix_ != NULL) { chkerr(MatDestroy(&matrix_)); }
     chkerr(VecDestroy(&rhs_));
 
@@ -460,6 +596,9 @@ void LinSys_PETSC::set_from_input(const Input::Record in_rec)
     // otherwise keep settings provided in constructor of LinSys_PETSC.
     std::string user_params = in_rec.val<string>("options");
 	if (user_params != "") params_ = user_params;
+
+	pc_lag_ = in_rec.val<unsigned int>("pc_lag");
+	pc_rebuild_factor_ = in_rec.val<double>("pc_rebuild_factor");
 }
 
 
@@ -123,8 +123,24 @@ public:
 
     void set_initial_guess_nonzero(bool set_nonzero = true);
 
+    /**
+     * Vectors are orthonormalized and attached to the matrix as its near null space.
+     * Linearly dependent vectors are dropped.
+     */
+    void set_near_nullspace(const std::vector<Vec> &vectors) override;
+
+    /// Coordinates are passed to the preconditioner (PCSetCoordinates) whenever it is rebuilt.
+    void set_coordinates(unsigned int dim, const std::vector<double> &coords) override;
+
     LinSys::SolveInfo solve() override;
 
+    /**
+     * Solve the system with the current matrix for another right hand side @p rhs.
+     * The result is stored in @p solution, which is also used as the initial guess.
+     * The KSP and its preconditioner are shared with solve(), which has to be called first.
+     */
+    LinSys::SolveInfo solve(Vec rhs, Vec solution);
+
     /**
      * Returns information on absolute solver accuracy
      */
@@ -184,9 +200,19 @@ protected:
 
     double  solution_precision_; // precision of KSP system solver
 
-    KSP                system;
+    KSP                system;   //!< Persistent KSP solver, created at the first solve.
     KSPConvergedReason reason;
 
+    unsigned int pc_lag_;        //!< Max. number of solves with lagged preconditioner after the matrix has changed.
+    double pc_rebuild_factor_;   //!< Lagged preconditioner is rebuilt if iterations grow by this factor.
+    Mat pc_matrix_;              //!< Matrix the current preconditioner was built for.
+    unsigned int n_lagged_solves_; //!< Number of solves with changed matrix since the last preconditioner setup.
+    int pc_setup_its_;           //!< Number of iterations of the first solve with the current preconditioner.
+
+    MatNullSpace near_null_space_;       //!< Near null space attached to the matrix, NULL if not set.
+    unsigned int coords_dim_;            //!< Space dimension of @p coords_.
+    std::vector<PetscReal> coords_;      //!< Coordinates of local rows for the preconditioner, empty if not set.
+
 
 };
 
@@ -114,7 +114,7 @@ SchurComplement::SchurComplement(Distribution *ds, IS ia, IS ib)
 
 SchurComplement::SchurComplement(SchurComplement &other)
 : LinSys_PETSC(other),
-  loc_size_A(other.loc_size_A), loc_size_B(other.loc_size_B), state(other.state),
+  loc_size_A(other.loc_size_A), loc_size_B(other.loc_size_B), block_sizes_(other.block_sizes_), state(other.state),
   Compl(other.Compl), ds_(other.ds_)
 {
 	MatCopy(other.A, A, DIFFERENT_NONZERO_PATTERN);
@@ -298,34 +298,31 @@ Distribution *SchurComplement::make_complement_distribution()
 	return ds_;
 }
 
-void SchurComplement::create_inversion_matrix()
+/**
+ * Inversion of a small dense block of fixed size. For sizes up to 4 Armadillo
+ * uses closed-form formulas for fixed-size matrices, which is significantly faster
+ * than the general LU based inversion.
+ */
+template <unsigned int N>
+static void invert_block(const double *block, double *inv_block)
 {
-    START_TIMER("create inversion matrix");
-    PetscInt ncols, pos_start, pos_start_IA;
-
-    MatReuse mat_reuse=MAT_REUSE_MATRIX;
-    if (state==created) mat_reuse=MAT_INITIAL_MATRIX; // indicate first construction
-
-    MatGetSubMatrix(matrix_, IsA, IsA, mat_reuse, &A);
-    MatDuplicate(A, MAT_DO_NOT_COPY_VALUES, &IA);
-    //MatGetSubMatrix(matrix_, IsA, IsA, mat_reuse, &IA);
+    arma::mat::fixed<N,N> submat(block);
+    arma::mat::fixed<N,N> invmat = arma::inv(submat);
+    std::copy(invmat.memptr(), invmat.memptr() + N*N, inv_block);
+}
 
-    MatGetOwnershipRange(A,&pos_start,PETSC_NULL);
-    MatGetOwnershipRange(IA,&pos_start_IA,PETSC_NULL);
 
-    std::vector<PetscInt> submat_rows;
+void SchurComplement::find_diagonal_blocks()
+{
+    PetscInt ncols, pos_start;
     const PetscInt *cols;
-    const PetscScalar *vals;
-
-    std::vector<unsigned int> processed_rows(loc_size_A,0);
 
-    unsigned int mat_block=1;   //actual processed block of matrix
-    for(unsigned int loc_row=0; loc_row < processed_rows.size(); loc_row++) {
-        if (processed_rows[loc_row] != 0) continue;
+    MatGetOwnershipRange(A,&pos_start,PETSC_NULL);
+    block_sizes_.clear();
 
+    for(PetscInt loc_row=0; loc_row < loc_size_A; ) {
         PetscInt min=std::numeric_limits<int>::max(), max=-1, size_submat;
         PetscInt b_vals = 0; // count of values stored in B-block of Orig system
-        submat_rows.clear();
         MatGetRow(A, loc_row + pos_start, &ncols, &cols, PETSC_NULL);
         for (PetscInt i=0; i<ncols; i++) {
             if (cols[i] < pos_start || cols[i] >= pos_start+loc_size_A) {
@@ -341,28 +338,72 @@ void SchurComplement::create_inversion_matrix()
         }
         size_submat = max - min + 1;
         OLD_ASSERT(ncols-b_vals == size_submat, "Submatrix cannot contains empty values.\n");
-
         MatRestoreRow(A, loc_row + pos_start, &ncols, &cols, PETSC_NULL);
-        arma::mat submat2(size_submat, size_submat);
-        submat2.zeros();
-        for (PetscInt i=0; i<size_submat; i++) {
-            processed_rows[ loc_row + i ] = mat_block;
-            submat_rows.push_back( i + loc_row + pos_start_IA );
+
+        block_sizes_.push_back(size_submat);
+        loc_row += size_submat;
+    }
+}
+
+
+void SchurComplement::create_inversion_matrix()
+{
+    START_TIMER("create inversion matrix");
+    PetscInt ncols, pos_start, pos_start_IA;
+
+    MatReuse mat_reuse=MAT_REUSE_MATRIX;
+    if (state==created) mat_reuse=MAT_INITIAL_MATRIX; // indicate first construction
+
+    MatGetSubMatrix(matrix_, IsA, IsA, mat_reuse, &A);
+    // Nonzero pattern of A is fixed, so the structure of IA and the layout
+    // of the diagonal blocks are determined only once.
+    if (state==created) {
+        MatDuplicate(A, MAT_DO_NOT_COPY_VALUES, &IA);
+        find_diagonal_blocks();
+    }
+
+    MatGetOwnershipRange(A,&pos_start,PETSC_NULL);
+    MatGetOwnershipRange(IA,&pos_start_IA,PETSC_NULL);
+
+    std::vector<PetscInt> submat_rows;
+    std::vector<double> submat, invmat;
+    const PetscInt *cols;
+    const PetscScalar *vals;
+
+    PetscInt loc_row = 0;
+    for(unsigned int size_submat : block_sizes_) {
+        submat_rows.resize(size_submat);
+        submat.assign(size_submat*size_submat, 0.0);
+        invmat.resize(size_submat*size_submat);
+
+        // column major dense block
+        for (PetscInt i=0; i<(PetscInt)size_submat; i++) {
+            submat_rows[i] = i + loc_row + pos_start_IA;
             MatGetRow(A, i + loc_row + pos_start, &ncols, &cols, &vals);
             for (PetscInt j=0; j<ncols; j++) {
                 if (cols[j] >= pos_start && cols[j] < pos_start+loc_size_A) {
-                    submat2( i, cols[j] - loc_row - pos_start ) = vals[j];
+                    submat[ (cols[j] - loc_row - pos_start)*size_submat + i ] = vals[j];
                 }
             }
             MatRestoreRow(A, i + loc_row + pos_start, &ncols, &cols, &vals);
 		}
+
         // get inversion matrix
-        arma::mat invmat = submat2.i();
+        switch (size_submat) {
+            case 1: invmat[0] = 1.0 / submat[0]; break;
+            case 2: invert_block<2>(&submat[0], &invmat[0]); break;
+            case 3: invert_block<3>(&submat[0], &invmat[0]); break;
+            case 4: invert_block<4>(&submat[0], &invmat[0]); break;
+            default: {
+                arma::mat inv_block = arma::inv( arma::mat(&submat[0], size_submat, size_submat, false) );
+                std::copy(inv_block.memptr(), inv_block.memptr() + inv_block.n_elem, invmat.begin());
+            }
+        }
+
         // stored to inversion IA matrix
-        const PetscInt* rows = &submat_rows[0];
-        MatSetValues(IA, submat_rows.size(), rows, submat_rows.size(), rows, invmat.memptr(), INSERT_VALUES);
+        MatSetValues(IA, size_submat, &submat_rows[0], size_submat, &submat_rows[0], &invmat[0], INSERT_VALUES);
 
-        mat_block++;
+        loc_row += size_submat;
     }
 
     MatAssemblyBegin(IA, MAT_FINAL_ASSEMBLY);
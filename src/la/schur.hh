@@ -19,6 +19,7 @@
 #ifndef LA_SCHUR_HH_
 #define LA_SCHUR_HH_
 
+#include <vector>              // for vector
 #include <petscmat.h>          // for Mat, _p_Mat
 #include "la/linsys_PETSC.hh"  // for LinSys_PETSC
 #include "petscistypes.h"      // for IS, _p_IS
@@ -141,12 +142,16 @@ protected:
     /// create IA matrix
     void create_inversion_matrix();
 
+    /// Find sizes of diagonal blocks of the A block, store them to @p block_sizes_.
+    void find_diagonal_blocks();
+
     void form_schur();
 
 
 
     Mat A;                      // Submatrix of matrix_ contains only data given by IsA parallel index set
     Mat IA;                     // Inverse of block A
+    std::vector<unsigned int> block_sizes_; // Sizes of diagonal blocks of A (local part)
 
     Mat B, Bt;                  // B and B' block (could be different from real B transpose)
     Mat C;                      // Sub matrix.
@@ -82,6 +82,13 @@ void SparseGraph::set_vtx_position(const int vtx, const float xyz[3],int weight)
 }
 
 
+void SparseGraph::set_vtx_weight(const int vtx, int weight)
+{
+    ASSERT(vtx_distr.is_local(vtx))(vtx).error("Can not set weight of nonlocal vertex.");
+    vtx_weights[vtx-vtx_distr.begin()]=weight;
+}
+
+
 /**
  *   Edge comparison. For lexical sorting of local edges.
  */
@@ -185,7 +192,11 @@ void SparseGraph::finalize()
    Edge *last_edge=&unknown_edge;
 
    for(i=0;i<size;i++) {
-       if (! (*last_edge < edges[i]) ) continue; // skip equivalent edges
+       if (! (*last_edge < edges[i]) ) {
+           // skip equivalent edges, keep the maximal weight
+           adj_weights[i_adj-1] = std::max(adj_weights[i_adj-1], edges[i].weight);
+           continue;
+       }
        last_edge=edges+i;
 
        OLD_ASSERT(vtx_distr.is_local(edges[i].from),
@@ -194,12 +205,12 @@ void SparseGraph::finalize()
        loc_from=edges[i].from-vtx_distr.begin();
        OLD_ASSERT( row <= loc_from, "Decrease in sorted edges at %d\n",i);
 
-       while ( row < loc_from ) rows[++row]=i;
+       while ( row < loc_from ) rows[++row]=i_adj;
        adj[i_adj]=edges[i].to;
        adj_weights[i_adj]=edges[i].weight;
        i_adj++;
    }
-   rows[++row]=i; // i==size (of adj array)
+   while ( row < (int)vtx_distr.lsize() ) rows[++row]=i_adj; // i_adj==size of adj array
 
    }
 
@@ -338,6 +349,13 @@ void SparseGraphPETSC::partition(int *loc_part)
             rows, adj,adj_weights, &petsc_adj_mat);
     MatPartitioningCreate(vtx_distr.get_comm(),& petsc_part);
     MatPartitioningSetAdjacency(petsc_part, petsc_adj_mat);
+    {
+        // the array is freed by the partitioning object
+        PetscInt *petsc_vtx_weights;
+        PetscMalloc(vtx_distr.lsize()*sizeof(PetscInt), &petsc_vtx_weights);
+        for (unsigned int i=0; i<vtx_distr.lsize(); i++) petsc_vtx_weights[i] = vtx_weights[i];
+        MatPartitioningSetVertexWeights(petsc_part, petsc_vtx_weights);
+    }
     MatPartitioningSetFromOptions(petsc_part);
     MatPartitioningApply(petsc_part,&part_IS);
 
@@ -89,6 +89,14 @@ public:
      */
     void set_vtx_position(const int vtx, const float xyz[3], int weight=1);
 
+    /**
+     * Set weight of a local vertex, i.e. estimate of its computational cost.
+     *
+     * @param[in] vtx - global vertex index (from zero)
+     * @param[in] weight - weight of the vertex
+     */
+    void set_vtx_weight(const int vtx, int weight);
+
     /**
      * @brief  Make sparse graph structures: rows, adj
      *
@@ -19,6 +19,7 @@
 #include "system/system.hh"
 #include "system/sys_profiler.hh"
 #include "system/python_loader.hh"
+#include "tools/step_metrics.hh"
 #include "coupling/hc_explicit_sequential.hh"
 #include "coupling/balance.hh"
 #include "input/accessors.hh"
@@ -85,6 +86,7 @@ Application::Application(FMT_UNUSED const std::string &python_path)
   //passed_argv_(0),
   use_profiler(true),
   profiler_path(""),
+  profiler_trace_path(""),
   yaml_balance_output_(false)
 {
     // initialize python stuff if we have
@@ -161,6 +163,9 @@ void Application::parse_cmd_line(const int argc, char ** argv) {
         ("no_signal_handler", "Turn off signal handling. Useful for debugging with valgrind.")
         ("no_profiler,no-profiler", "Turn off profiler output.")
         ("profiler_path,profiler-path", po::value< string >(), "Path to the profiler file")
+        ("profiler_counters,profiler-counters", "Measure hardware performance counters in profiler timers (Linux only).")
+        ("step_metrics,step-metrics", po::value< string >(), "Write performance metrics of every time step of every equation into given file (JSON lines).")
+        ("profiler_trace,profiler-trace", po::value< string >(), "Record timeline of timers of all processes into given file (Chrome trace format).")
         ("input_format", po::value< string >(), "Writes full structure of the main input file into given file.")
 		("petsc_redirect", po::value<string>(), "Redirect all PETSc stdout and stderr to given file.")
 		("yaml_balance", "Redirect balance output to YAML format too (simultaneously with the selected balance output format).");
@@ -206,6 +211,20 @@ void Application::parse_cmd_line(const int argc, char ** argv) {
         profiler_path = vm["profiler_path"].as<string>();
     }
 
+    if (vm.count("profiler_counters")) {
+        Profiler::set_perf_counters(true);
+    }
+
+    if (vm.count("step_metrics")) {
+        StepMetrics::set_file(vm["step_metrics"].as<string>());
+    }
+
+    // possibly turn on timeline recording
+    if (vm.count("profiler_trace")) {
+        profiler_trace_path = vm["profiler_trace"].as<string>();
+        ProfilerTrace::enable();
+    }
+
     // if there is "help" option
     if (vm.count("help")) {
         display_version();
@@ -394,6 +413,12 @@ void Application::terminate() {
 Application::~Application() {
 	if (problem_) delete problem_;
 
+    if (ProfilerTrace::is_enabled()) {
+        string trace_file = FilePath(profiler_trace_path, FilePath::output_file);
+        ProfilerTrace::output(petsc_initialized ? PETSC_COMM_WORLD : MPI_COMM_WORLD, trace_file);
+        ProfilerTrace::disable();
+    }
+
     if (use_profiler) {
         if (petsc_initialized) {
             // log profiler data to this stream
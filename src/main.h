@@ -113,6 +113,9 @@ private:
     /// location of the profiler report file
     string profiler_path;
 
+    /// location of the timeline trace file, used if the ProfilerTrace is enabled
+    string profiler_trace_path;
+
     /// If true, preserves output of balance in YAML format.
     bool yaml_balance_output_;
 
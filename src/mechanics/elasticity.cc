@@ -347,6 +347,15 @@ void Elasticity::initialize()
     ( (LinSys_PETSC *)ls )->set_from_input( input_rec.val<Input::Record>("solver") );
     ls->set_solution(data_.output_field_ptr->vec().petsc_vec());
 
+    // rigid body modes for algebraic multigrid preconditioners (GAMG, BoomerAMG nodal variants);
+    // coordinates are not passed since GAMG would then build its own (scalar) near null space
+    {
+        std::vector<VectorMPI> modes = feo->dh()->rigid_body_modes();
+        std::vector<Vec> mode_vecs;
+        for (auto &mode : modes) mode_vecs.push_back(mode.petsc_vec());
+        ls->set_near_nullspace(mode_vecs);
+    }
+
     // initialization of balance object
 //     balance_->allocate(feo->dh()->distr()->lsize(),
 //             max(feo->fe<1>()->n_dofs(), max(feo->fe<2>()->n_dofs(), feo->fe<3>()->n_dofs())));
@@ -381,14 +390,14 @@ void Elasticity::update_output_fields()
     compute_output_fields<2>();
     compute_output_fields<3>();
 
-    // update ghost values of computed fields
+    // update ghost values of computed fields, all messages are started before waiting for any of them
     data_.output_stress_ptr->vec().local_to_ghost_begin();
-    data_.output_stress_ptr->vec().local_to_ghost_end();
     data_.output_von_mises_stress_ptr->vec().local_to_ghost_begin();
-    data_.output_von_mises_stress_ptr->vec().local_to_ghost_end();
     data_.output_cross_section_ptr->vec().local_to_ghost_begin();
-    data_.output_cross_section_ptr->vec().local_to_ghost_end();
     data_.output_div_ptr->vec().local_to_ghost_begin();
+    data_.output_stress_ptr->vec().local_to_ghost_end();
+    data_.output_von_mises_stress_ptr->vec().local_to_ghost_end();
+    data_.output_cross_section_ptr->vec().local_to_ghost_end();
     data_.output_div_ptr->vec().local_to_ghost_end();
 }
 
@@ -475,6 +484,8 @@ void Elasticity::solve_linear_system()
     START_TIMER("data reinit");
     data_.set_time(time_->step(), LimitSide::right);
     END_TIMER("data reinit");
+
+    StepMetrics::PhaseTimer assembly_timer(time_->metrics(), StepMetrics::assembly);
     
     // assemble stiffness matrix
     if (stiffness_matrix == NULL
@@ -493,6 +504,8 @@ void Elasticity::solve_linear_system()
     }
 
     // assemble right hand side (due to sources and boundary conditions)
+    // If only the rhs is reassembled (e.g. new potential load in HM iteration),
+    // the linear system keeps its preconditioner for the unchanged matrix.
     if (rhs == NULL
         || data_.subset(FieldFlag::in_rhs).changed())
     {
@@ -506,8 +519,13 @@ void Elasticity::solve_linear_system()
         VecCopy(*( ls->get_rhs() ), rhs);
     }
 
+    assembly_timer.stop();
+
     START_TIMER("solve");
+    StepMetrics::PhaseTimer solve_timer(time_->metrics(), StepMetrics::solve);
     LinSys::SolveInfo si = ls->solve();
+    solve_timer.stop();
+    time_->metrics().add_linear_solve(si.n_iterations);
     MessageOut().fmt("[mech solver] lin. it: {}, reason: {}, residual: {}\n",
         		si.n_iterations, si.converged_reason, ls->compute_residual());
     END_TIMER("solve");
@@ -521,6 +539,7 @@ void Elasticity::solve_linear_system()
 void Elasticity::output_data()
 {
     START_TIMER("MECH-OUTPUT");
+    StepMetrics::PhaseTimer metrics_timer(time_->metrics(), StepMetrics::output);
 
     // gather the solution from all processors
     data_.output_fields.set_time( this->time().step(), LimitSide::left);
@@ -154,6 +154,11 @@ public:
         return mesh_ != NULL;
     }
 
+    /// Return pointer to the mesh owning the element.
+    const Mesh *mesh() const {
+        return mesh_;
+    }
+
     unsigned int dim() const
         { return dim_; }
 
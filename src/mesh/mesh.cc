@@ -19,6 +19,10 @@
 #include <unistd.h>
 #include <set>
 #include <unordered_map>
+#include <array>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
 
 #include "system/system.hh"
 #include "system/exceptions.hh"
@@ -43,6 +47,7 @@
 
 
 #include "mesh/bih_tree.hh"
+#include "mesh/mesh_geometry.hh"
 #include "mesh/duplicate_nodes.h"
 
 #include "intersection/mixed_mesh_intersections.hh"
@@ -92,6 +97,13 @@ const IT::Record & Mesh::get_input_type() {
                      "element in plan view (Z projection).")
         .declare_key("raw_ngh_output", IT::FileName::output(), IT::Default::optional(),
                      "Output file with neighboring data from mesh.")
+        .declare_key("geometry_cache", IT::Bool(), IT::Default("false"),
+                     "If true, Jacobians, normals and volume elements of all bulk elements are computed once "
+                     "and reused in assembly. Increases memory usage by approx. 200 bytes per element.")
+        .declare_key("reorder_elements", IT::Bool(), IT::Default("false"),
+                     "If true, bulk elements are reordered along a space filling (Hilbert) curve and nodes "
+                     "in order of their use by elements. Improves memory locality of assembly and bandwidth "
+                     "of matrices. IDs of elements and nodes are preserved.")
 		.close();
 }
 
@@ -106,6 +118,8 @@ Mesh::Mesh()
   el_ds(nullptr),
   node_4_loc_(nullptr),
   node_ds_(nullptr),  
+  use_geometry_cache_(false),
+  elements_reordered_(false),
   bc_mesh_(nullptr)
   
 {}
@@ -123,6 +137,8 @@ Mesh::Mesh(Input::Record in_record, MPI_Comm com)
   el_ds(nullptr),
   node_4_loc_(nullptr),
   node_ds_(nullptr),
+  use_geometry_cache_(false),
+  elements_reordered_(false),
   bc_mesh_(nullptr)
 {
 	// set in_record_, if input accessor is empty
@@ -134,6 +150,7 @@ Mesh::Mesh(Input::Record in_record, MPI_Comm com)
 	    reader.read_stream(is, in_rec, Input::FileFormat::format_JSON);
 	    in_record_ = reader.get_root_interface<Input::Record>();
 	}
+	use_geometry_cache_ = in_record_.val<bool>("geometry_cache");
 
         int rank;
         MPI_Comm_rank(MPI_COMM_WORLD, &rank);
@@ -385,11 +402,131 @@ void Mesh::check_mesh_on_read() {
     }
 }
 
+namespace {
+
+/**
+ * Index of a point on the 3D Hilbert curve of given @p order (bits per axis),
+ * coordinates are integers in [0, 2^order). Skilling's transposition algorithm.
+ */
+uint64_t hilbert_index(std::array<uint32_t, 3> x, unsigned int order)
+{
+    const unsigned int n = 3;
+    uint32_t m = 1u << (order-1), p, t;
+
+    // inverse undo excess work
+    for (uint32_t q = m; q > 1; q >>= 1) {
+        p = q - 1;
+        for (unsigned int i=0; i<n; i++)
+            if (x[i] & q) x[0] ^= p;
+            else {
+                t = (x[0] ^ x[i]) & p;
+                x[0] ^= t;
+                x[i] ^= t;
+            }
+    }
+
+    // Gray encode
+    for (unsigned int i=1; i<n; i++) x[i] ^= x[i-1];
+    t = 0;
+    for (uint32_t q = m; q > 1; q >>= 1)
+        if (x[n-1] & q) t ^= q - 1;
+    for (unsigned int i=0; i<n; i++) x[i] ^= t;
+
+    // interleave bits of the transposed index
+    uint64_t index = 0;
+    for (int b = order-1; b >= 0; b--)
+        for (unsigned int i=0; i<n; i++)
+            index = (index << 1) | ((x[i] >> b) & 1);
+    return index;
+}
+
+}
+
+
+void Mesh::reorder_elements() {
+    START_TIMER("MESH - reorder elements");
+    static const unsigned int order = 21;  // 3*21 bits of the Hilbert index
+    ASSERT(element_vec_.size() == bulk_size_).error("Boundary elements must not be created before reordering.\n");
+
+    // bounding box of nodes
+    arma::vec3 min_coord, max_coord;
+    min_coord.fill( std::numeric_limits<double>::max() );
+    max_coord.fill( -std::numeric_limits<double>::max() );
+    for (uint inode = 0; inode < n_nodes(); inode++) {
+        min_coord = arma::min(min_coord, nodes_.vec<3>(inode));
+        max_coord = arma::max(max_coord, nodes_.vec<3>(inode));
+    }
+    arma::vec3 scale;
+    for (uint i=0; i<3; i++) {
+        double extent = max_coord[i] - min_coord[i];
+        scale[i] = (extent > 0.0) ? ((1u << order) - 1) / extent : 0.0;
+    }
+
+    // sort elements by Hilbert index of their barycenters
+    std::vector<std::pair<uint64_t, uint>> elm_keys(bulk_size_);
+    for (uint i_elm = 0; i_elm < bulk_size_; i_elm++) {
+        const Element &ele = element_vec_[i_elm];
+        arma::vec3 center = arma::zeros(3);
+        for (uint i_node=0; i_node<ele.n_nodes(); i_node++) center += nodes_.vec<3>(ele.node_idx(i_node));
+        center = (center / ele.n_nodes() - min_coord) % scale;
+        std::array<uint32_t, 3> coords;
+        for (uint i=0; i<3; i++) coords[i] = (uint32_t)center[i];
+        elm_keys[i_elm] = std::make_pair(hilbert_index(coords, order), i_elm);
+    }
+    std::sort(elm_keys.begin(), elm_keys.end());
+
+    // nodes in order of their first use
+    std::vector<uint> node_new_idx(n_nodes(), Mesh::undef_idx);
+    std::vector<uint> node_old_idx;
+    node_old_idx.reserve(n_nodes());
+    for (auto &key : elm_keys) {
+        const Element &ele = element_vec_[key.second];
+        for (uint i_node=0; i_node<ele.n_nodes(); i_node++) {
+            uint inode = ele.node_idx(i_node);
+            if (node_new_idx[inode] == Mesh::undef_idx) {
+                node_new_idx[inode] = node_old_idx.size();
+                node_old_idx.push_back(inode);
+            }
+        }
+    }
+    ASSERT_EQ(node_old_idx.size(), n_nodes());
+
+    // permute nodes
+    Armor::Array<double> new_nodes(3, 1, n_nodes());
+    BidirectionalMap<int> new_node_ids;
+    new_node_ids.reserve(n_nodes());
+    for (uint inode = 0; inode < node_old_idx.size(); inode++) {
+        new_nodes.set(inode) = nodes_.vec<3>(node_old_idx[inode]);
+        new_node_ids.add_item(node_ids_[node_old_idx[inode]]);
+    }
+    nodes_ = new_nodes;
+    node_ids_ = new_node_ids;
+
+    // permute elements, element has no topology data yet
+    vector<Element> new_element_vec;
+    BidirectionalMap<int> new_element_ids;
+    new_element_vec.reserve(element_vec_.size());
+    new_element_ids.reserve(element_vec_.size());
+    for (auto &key : elm_keys) {
+        new_element_vec.push_back( element_vec_[key.second] );
+        new_element_ids.add_item( element_ids_[key.second] );
+        Element &ele = new_element_vec.back();
+        for (uint i_node=0; i_node<ele.n_nodes(); i_node++)
+            ele.nodes_[i_node] = node_new_idx[ ele.nodes_[i_node] ];
+    }
+    element_vec_.swap(new_element_vec);
+    element_ids_ = new_element_ids;
+
+    elements_reordered_ = true;
+}
+
+
 void Mesh::setup_topology() {
     START_TIMER("MESH - setup topology");
     
     count_element_types();
     check_mesh_on_read();
+    if ( in_record_.val<bool>("reorder_elements") ) reorder_elements();
 
     make_neighbours_and_edges();
     element_to_neigh_vb();
@@ -1056,6 +1193,14 @@ const BIHTree &Mesh::get_bih_tree() {
     return *bih_tree_;
 }
 
+const MeshGeometry *Mesh::geometry() const {
+    if (! use_geometry_cache_) return nullptr;
+    if (! this->geometry_) {
+        geometry_ = std::make_shared<MeshGeometry>(*this);
+    }
+    return geometry_.get();
+}
+
 double Mesh::global_snap_radius() const {
 	return in_record_.val<double>("global_snap_radius");
 }
@@ -52,6 +52,7 @@ class Boundary;
 class Edge;
 class BCMesh;
 class DuplicateNodes;
+class MeshGeometry;
 template <int spacedim> class ElementAccessor;
 template <int spacedim> class NodeAccessor;
 
@@ -297,6 +298,19 @@ public:
     /// Getter for BIH. Creates and compute BIH at first call.
     const BIHTree &get_bih_tree();\
 
+    /**
+     * Getter for precomputed geometry data of bulk elements. Creates the data at first call.
+     * Returns nullptr if the geometry cache is not switched on in the input.
+     */
+    const MeshGeometry *geometry() const;
+
+    /**
+     * Return true if bulk elements and nodes were reordered along a space filling curve
+     * (input key "reorder_elements"), i.e. their indices do not follow order of IDs in the mesh file.
+     */
+    inline bool elements_reordered() const
+    { return elements_reordered_; }
+
     /**
      * Find intersection of element lists given by Mesh::node_elements_ for elements givne by @p nodes_list parameter.
      * The result is placed into vector @p intersection_element_list. If the @p node_list is empty, and empty intersection is
@@ -459,6 +473,13 @@ protected:
      */
     void check_mesh_on_read();
 
+    /**
+     * Reorder bulk elements along the Hilbert curve through their barycenters and nodes in order
+     * of their first use by the reordered elements. IDs of elements and nodes are preserved.
+     * Must be called before any topology structure is created.
+     */
+    void reorder_elements();
+
     /**
      * Possibly modify region id of elements sets by user in "regions" part of input file.
      *
@@ -569,6 +590,12 @@ private:
     Distribution *node_ds_;
     /// Hold number of local nodes (own + ghost), value is equal with size of node_4_loc array.
     unsigned int n_local_nodes_;
+    /// True if geometry data of elements are precomputed (input key "geometry_cache").
+    bool use_geometry_cache_;
+    /// True if bulk elements and nodes are reordered (input key "reorder_elements").
+    bool elements_reordered_;
+    /// Precomputed geometry of bulk elements. Created at first call of geometry().
+    mutable std::shared_ptr<MeshGeometry> geometry_;
 	/// Boundary mesh, object is created only if it's necessary
 	BCMesh *bc_mesh_;
         
@@ -0,0 +1,112 @@
+/*!
+ *
+ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    mesh_geometry.cc
+ * @brief   Precomputed geometry data of affine (P1) mesh elements.
+ */
+
+#include "mesh/mesh_geometry.hh"
+#include "mesh/mesh.h"
+#include "mesh/accessors.hh"
+#include "mesh/ref_element.hh"
+#include "fem/mapping.hh"                       // for determinant
+
+
+namespace {
+
+/// Volume element of a side of a @p dim dimensional element.
+template<unsigned int dim>
+double side_volume_element(const Side &side)
+{
+    arma::mat::fixed<3,dim-1> side_jac;
+    arma::vec3 origin = *side.node(0);
+    for (unsigned int n=1; n<dim; n++)
+        side_jac.col(n-1) = *side.node(n) - origin;
+    return fabs(::determinant(side_jac));
+}
+
+/// Sides of 1D elements are points.
+template<>
+double side_volume_element<1>(FMT_UNUSED const Side &side)
+{
+    return 1.0;
+}
+
+}
+
+
+MeshGeometry::MeshGeometry(const Mesh &mesh)
+{
+    unsigned int n_elm = mesh.n_elements();
+    jac_.resize(9*n_elm, 0.0);
+    inv_jac_.resize(9*n_elm, 0.0);
+    det_.resize(n_elm);
+    side_offset_.resize(n_elm+1);
+
+    side_offset_[0] = 0;
+    for (unsigned int i=0; i<n_elm; i++)
+        side_offset_[i+1] = side_offset_[i] + mesh.element_accessor(i)->n_sides();
+    side_det_.resize(side_offset_[n_elm]);
+    normal_.resize(3*side_offset_[n_elm]);
+
+    for (auto elm : mesh.elements_range()) {
+        switch (elm.dim()) {
+            case 1:
+                fill_element<1>(elm);
+                break;
+            case 2:
+                fill_element<2>(elm);
+                break;
+            case 3:
+                fill_element<3>(elm);
+                break;
+            default:
+                ASSERT(false)(elm.dim()).error("Unsupported dimension.\n");
+                break;
+        }
+    }
+}
+
+
+template<unsigned int dim>
+void MeshGeometry::fill_element(const ElementAccessor<3> &elm)
+{
+    unsigned int elm_idx = elm.mesh_idx();
+
+    arma::mat::fixed<3,dim> jac;
+    arma::vec3 origin = *elm.node(0);
+    for (unsigned int j=0; j<dim; j++)
+        jac.col(j) = *elm.node(j+1) - origin;
+
+    arma::mat::fixed<dim,3> ijac;
+    if (dim == 3)
+        ijac = arma::inv(jac);
+    else
+        ijac = arma::pinv(jac);
+
+    det_[elm_idx] = fabs(::determinant(jac));
+    for (unsigned int j=0; j<dim; j++)
+        for (unsigned int i=0; i<3; i++)
+            jac_[9*elm_idx+3*j+i] = jac(i,j);
+    for (unsigned int j=0; j<3; j++)
+        for (unsigned int i=0; i<dim; i++)
+            inv_jac_[9*elm_idx+3*j+i] = ijac(i,j);
+
+    for (unsigned int sid=0; sid<elm->n_sides(); sid++) {
+        unsigned int s = side_offset_[elm_idx]+sid;
+        arma::vec3 n = trans(ijac)*RefElement<dim>::normal_vector(sid);
+        n = n/arma::norm(n,2);
+        for (unsigned int i=0; i<3; i++) normal_[3*s+i] = n[i];
+        side_det_[s] = side_volume_element<dim>(*elm.side(sid));
+    }
+}
@@ -0,0 +1,123 @@
+/*!
+ *
+ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    mesh_geometry.hh
+ * @brief   Precomputed geometry data of affine (P1) mesh elements.
+ */
+
+#ifndef MESH_GEOMETRY_HH_
+#define MESH_GEOMETRY_HH_
+
+#include <vector>                              // for vector
+#include <armadillo>
+#include "system/asserts.hh"                   // for ASSERT_LT_DBG
+
+class Mesh;
+template <int spacedim> class ElementAccessor;
+
+
+/**
+ * @brief Mesh-wide store of geometry data of bulk elements.
+ *
+ * All bulk elements are affine (P1), so the Jacobian of the reference-to-real mapping,
+ * its (pseudo)inverse, the volume element, the side normals and the side volume elements
+ * are constant over each element and can be computed once per mesh instead of on every
+ * ElementValues::reinit(). Data are stored in flat arrays (one array per quantity) indexed
+ * by element index; matrices are stored column-wise in fixed 3x3 blocks, side data are
+ * addressed through @p side_offset_.
+ *
+ * The store is optional and is created by Mesh::geometry() if the input key
+ * "geometry_cache" is set. Boundary elements are not stored.
+ */
+class MeshGeometry {
+public:
+    /// Compute geometry data of all bulk elements of the @p mesh.
+    MeshGeometry(const Mesh &mesh);
+
+    /// Return true if data of the element given by its index in the element vector are stored.
+    inline bool contains(unsigned int elm_idx) const
+    { return elm_idx < det_.size(); }
+
+    /// Return Jacobian of the mapping of element @p elm_idx.
+    template<unsigned int dim>
+    inline arma::mat::fixed<3,dim> jacobian(unsigned int elm_idx) const
+    {
+        ASSERT_LT_DBG(elm_idx, det_.size());
+        const double *p = &jac_[9*elm_idx];
+        arma::mat::fixed<3,dim> jac;
+        for (unsigned int j=0; j<dim; j++)
+            for (unsigned int i=0; i<3; i++)
+                jac(i,j) = p[3*j+i];
+        return jac;
+    }
+
+    /// Return inverse Jacobian (pseudoinverse for dim<3) of element @p elm_idx.
+    template<unsigned int dim>
+    inline arma::mat::fixed<dim,3> inverse_jacobian(unsigned int elm_idx) const
+    {
+        ASSERT_LT_DBG(elm_idx, det_.size());
+        const double *p = &inv_jac_[9*elm_idx];
+        arma::mat::fixed<dim,3> ijac;
+        for (unsigned int j=0; j<3; j++)
+            for (unsigned int i=0; i<dim; i++)
+                ijac(i,j) = p[3*j+i];
+        return ijac;
+    }
+
+    /// Return absolute value of Jacobian determinant of element @p elm_idx.
+    inline double determinant(unsigned int elm_idx) const
+    {
+        ASSERT_LT_DBG(elm_idx, det_.size());
+        return det_[elm_idx];
+    }
+
+    /// Return unit outer normal vector of side @p side_idx of element @p elm_idx.
+    inline arma::vec3 normal_vector(unsigned int elm_idx, unsigned int side_idx) const
+    {
+        const double *p = &normal_[3*side_index(elm_idx, side_idx)];
+        return arma::vec3({p[0], p[1], p[2]});
+    }
+
+    /// Return volume element (Jacobian determinant) of side @p side_idx of element @p elm_idx.
+    inline double side_determinant(unsigned int elm_idx, unsigned int side_idx) const
+    { return side_det_[side_index(elm_idx, side_idx)]; }
+
+private:
+    /// Compute data of one element.
+    template<unsigned int dim>
+    void fill_element(const ElementAccessor<3> &elm);
+
+    /// Return index of side into the side data arrays.
+    inline unsigned int side_index(unsigned int elm_idx, unsigned int side_idx) const
+    {
+        ASSERT_LT_DBG(elm_idx, det_.size());
+        ASSERT_LT_DBG(side_offset_[elm_idx]+side_idx, side_offset_[elm_idx+1]);
+        return side_offset_[elm_idx]+side_idx;
+    }
+
+    /// Jacobians, 9 values per element (column-wise, 3 x dim used).
+    std::vector<double> jac_;
+    /// Inverse Jacobians, 9 values per element (column-wise, dim x 3 used).
+    std::vector<double> inv_jac_;
+    /// Absolute values of Jacobian determinants.
+    std::vector<double> det_;
+    /// Start of the element's sides in side data arrays, size n_elements+1.
+    std::vector<unsigned int> side_offset_;
+    /// Volume elements of sides.
+    std::vector<double> side_det_;
+    /// Unit normal vectors of sides, 3 values per side.
+    std::vector<double> normal_;
+};
+
+
+#endif /* MESH_GEOMETRY_HH_ */
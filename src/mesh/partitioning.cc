@@ -46,10 +46,23 @@ const IT::Selection & Partitioning::get_tool_sel() {
 		.close();
 }
 
+const IT::Selection & Partitioning::get_element_weights_sel() {
+	return IT::Selection("PartitionElementWeights", "Estimate of the computational cost of elements used to balance the partitions.")
+		.add_value(uniform_weights, "uniform", "All elements have the same weight.")
+		.add_value(coupling_weights, "couplings", "Weight of an element is one plus the number of elements coupled with it, "
+		        "i.e. elements sharing a side or connected through a lower dimensional element.")
+		.close();
+}
+
 const IT::Record & Partitioning::get_input_type() {
     static IT::Record input_type = IT::Record("Partition","Setting for various types of mesh partitioning." )
 		.declare_key("tool", Partitioning::get_tool_sel(), IT::Default("\"METIS\""),  "Software package used for partitioning. See corresponding selection.")
 		.declare_key("graph_type", Partitioning::get_graph_type_sel(), IT::Default("\"any_neighboring\""), "Algorithm for generating graph and its weights from a multidimensional mesh.")
+		.declare_key("element_weights", Partitioning::get_element_weights_sel(), IT::Default("\"uniform\""),
+		        "Estimate of the computational cost of elements.")
+		.declare_key("dimension_weights", IT::Array(IT::Integer(1), 3, 3), IT::Default("[1, 1, 1]"),
+		        "Multipliers of the element weights for elements of dimension 1, 2 and 3. "
+		        "Allows to account for different cost of elements of different dimension, e.g. fractures.")
 		.allow_auto_conversion("graph_type") // mainly in order to allow Default value for the whole record Partition
 		.close();
     input_type.finish();
@@ -98,12 +111,19 @@ void Partitioning::make_element_connection_graph() {
     int i_s, n_s;
 
     // Add nigbouring edges only for "any_*" graph types
-    bool neigh_on = ( in_.val<PartitionGraphType>("graph_type") != same_dimension_neighboring );
+    PartitionGraphType graph_type = in_.val<PartitionGraphType>("graph_type");
+    bool neigh_on = ( graph_type != same_dimension_neighboring );
+    int neigh_weight = ( graph_type == any_weight_lower_dim_cuts ) ? lower_dim_cut_weight : 1;
+
+    ElementWeights element_weights = in_.val<ElementWeights>("element_weights");
+    std::vector<int> dim_weights;
+    in_.val<Input::Array>("dimension_weights").copy_to(dim_weights);
 
     for (auto ele : mesh_->elements_range()) {
         // skip non-local elements
         if ( !edistr.is_local( ele.idx() ) )
             continue;
+        int n_couplings = 0;
 
         // for all connected elements
         for (unsigned int si=0; si<ele->n_sides(); si++) {
@@ -116,6 +136,7 @@ void Partitioning::make_element_connection_graph() {
                 // for elements of connected elements, excluding element itself
                 if ( e_idx != ele.idx() ) {
                     graph_->set_edge( ele.idx(), e_idx );
+                    n_couplings++;
                 }
             }
         }
@@ -127,11 +148,15 @@ void Partitioning::make_element_connection_graph() {
                n_s = ele->neigh_vb[i_neigh]->edge().n_sides();
                 for (i_s = 0; i_s < n_s; i_s++) {
                    e_idx = ele->neigh_vb[i_neigh]->edge().side(i_s)->element().idx();
-                    graph_->set_edge( ele.idx(), e_idx );
-                    graph_->set_edge( e_idx, ele.idx() );
+                    graph_->set_edge( ele.idx(), e_idx, neigh_weight );
+                    graph_->set_edge( e_idx, ele.idx(), neigh_weight );
+                    n_couplings++;
                 }
             }
         }
+
+        int weight = (element_weights == coupling_weights) ? 1 + n_couplings : 1;
+        graph_->set_vtx_weight( ele.idx(), weight * dim_weights[ele->dim()-1] );
     }
     graph_->finalize();
 }
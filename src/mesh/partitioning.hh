@@ -55,6 +55,7 @@ public:
     /// Input specification objects.
     static const Input::Type::Selection & get_graph_type_sel();
     static const Input::Type::Selection & get_tool_sel();
+    static const Input::Type::Selection & get_element_weights_sel();
     static const Input::Type::Record & get_input_type();
 
 	TYPEDEF_ERR_INFO(EI_MeshFile, std::string);
@@ -115,6 +116,17 @@ private:
         same_dimension_neighboring,     ///< Add edge for any pair of neighboring elements of same dimension (bad for matrix multiply)
     };
 
+    /**
+     * Estimates of the computational cost of elements (vertex weights of the graph).
+     */
+    enum ElementWeights {
+        uniform_weights,               ///< Unit weight of all elements.
+        coupling_weights               ///< Weight given by number of elements coupled with the element.
+    };
+
+    /// Weight of graph edges between elements of different dimension for graph type any_weight_lower_dim_cuts.
+    static const int lower_dim_cut_weight = 10;
+
     /// The input mesh
     Mesh        *mesh_;
     /// Input Record accessor.
@@ -53,6 +53,7 @@ void FirstOrderReactionBase::initialize()
 
     // allocation
     prev_conc_.resize(n_substances_);
+    new_conc_.resize(n_substances_);
     reaction_matrix_.resize(n_substances_, n_substances_);
     molar_matrix_.resize(n_substances_, n_substances_);
     molar_mat_inverse_.resize(n_substances_, n_substances_);
@@ -84,7 +85,6 @@ void FirstOrderReactionBase::zero_time_step()
 void FirstOrderReactionBase::compute_reaction(const DHCellAccessor& dh_cell)
 {      
     unsigned int sbi;  // row in the concentration matrix, regards the substance index
-    arma::vec new_conc;
     
     IntIdx dof_p0 = dh_cell.get_loc_dof_indices()[0];
 
@@ -93,11 +93,11 @@ void FirstOrderReactionBase::compute_reaction(const DHCellAccessor& dh_cell)
         prev_conc_(sbi) = conc_mobile_fe[sbi]->vec()[dof_p0];
     
     // compute new concetrations R*c
-    linear_ode_solver_->update_solution(prev_conc_, new_conc);
+    linear_ode_solver_->update_solution(prev_conc_, new_conc_);
     
     // save new concentrations to the concentration matrix
     for(sbi = 0; sbi < n_substances_; sbi++)
-        conc_mobile_fe[sbi]->vec()[dof_p0] = new_conc(sbi);
+        conc_mobile_fe[sbi]->vec()[dof_p0] = new_conc_(sbi);
 }
 
 void FirstOrderReactionBase::update_solution(void)
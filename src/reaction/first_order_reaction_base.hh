@@ -108,6 +108,7 @@ protected:
     
     arma::mat reaction_matrix_;   ///< Reaction matrix.
     arma::vec prev_conc_;      ///< Column vector storing previous concetrations on an element.
+    arma::vec new_conc_;       ///< Column vector storing new concetrations on an element, reused in all elements.
     
     arma::mat molar_matrix_;      ///< Diagonal matrix with molar masses of substances.
     arma::mat molar_mat_inverse_; ///< Inverse of @p molar_matrix_.
@@ -0,0 +1,164 @@
+/*!
+ *
+ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    arena_allocator.hh
+ * @ingroup system
+ * @brief   Bump (arena) allocator for short living temporary data.
+ */
+
+#ifndef ARENA_ALLOCATOR_HH_
+#define ARENA_ALLOCATOR_HH_
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <algorithm>
+
+
+namespace internal {
+
+    /**
+     * Arena of memory blocks. Allocation only moves a position in the actual block,
+     * individual deallocation is not possible. All the memory is released at once by
+     * @p reset(), which keeps the blocks for the next use, so after the first few
+     * cycles (e.g. assembly steps) no system allocation is done at all.
+     *
+     * Blocks are allocated by malloc, so they are not included in the memory consumption
+     * monitored by the Profiler (same as SimpleAllocator).
+     *
+     * The arena is not thread safe, every thread (or object) has to use its own.
+     */
+    class Arena {
+    public:
+        /// Default size of one block in bytes.
+        static const std::size_t default_block_size = 16 * 1024;
+
+        /// Constructor, no memory is allocated until the first allocation.
+        explicit Arena(std::size_t block_size = default_block_size)
+        : current_(0), pos_(0), block_size_(block_size)
+        {}
+
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        ~Arena() {
+            for (Block &b : blocks_) free(b.data);
+        }
+
+        /// Return @p size bytes aligned to @p align (power of two, at most alignof(max_align_t)).
+        inline void *allocate(std::size_t size, std::size_t align = alignof(std::max_align_t)) {
+            std::size_t pos = (pos_ + align - 1) & ~(align - 1);
+            if (current_ < blocks_.size() && pos + size <= blocks_[current_].size) {
+                pos_ = pos + size;
+                return blocks_[current_].data + pos;
+            }
+            return allocate_block(size);
+        }
+
+        /// Release all allocated memory, blocks are kept for reuse.
+        inline void reset() {
+            current_ = 0;
+            pos_ = 0;
+        }
+
+        /// Total size of allocated blocks in bytes.
+        std::size_t capacity() const {
+            std::size_t sum = 0;
+            for (const Block &b : blocks_) sum += b.size;
+            return sum;
+        }
+
+    private:
+        struct Block {
+            char *data;
+            std::size_t size;
+        };
+
+        /// Continue in the next block large enough for @p size, allocate new block if there is none.
+        void *allocate_block(std::size_t size) {
+            std::size_t i = (current_ < blocks_.size() ? current_ + 1 : current_);
+            for (; i < blocks_.size(); ++i)
+                if (size <= blocks_[i].size) {
+                    current_ = i;
+                    pos_ = size;
+                    return blocks_[i].data;
+                }
+
+            Block b;
+            b.size = std::max(block_size_, size);
+            b.data = (char *) malloc(b.size);
+            if (b.data == nullptr) throw std::bad_alloc();
+            blocks_.push_back(b);
+            current_ = blocks_.size() - 1;
+            pos_ = size;
+            return b.data;
+        }
+
+        /// Allocated blocks.
+        std::vector<Block> blocks_;
+        /// Index of the actual block.
+        std::size_t current_;
+        /// Position of the first free byte in the actual block.
+        std::size_t pos_;
+        /// Minimal size of a new block.
+        std::size_t block_size_;
+    };
+
+
+    /**
+     * STL allocator taking memory from an Arena. Deallocation does nothing, memory is
+     * released by Arena::reset(). A container using the allocator must not hold any
+     * memory when the arena is reset (e.g. std::map or std::list after clear(); not
+     * std::unordered_map, which keeps its bucket array).
+     */
+    template<class T>
+    class ArenaAllocator {
+    public:
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef T value_type;
+
+        explicit ArenaAllocator(Arena &arena) : arena_(&arena) { }
+
+        template<class U>
+        ArenaAllocator(const ArenaAllocator<U> &other) : arena_(other.arena_) { }
+
+        pointer allocate(size_type n, const void * = 0) {
+            return static_cast<pointer>( arena_->allocate(n * sizeof(T), alignof(T)) );
+        }
+
+        void deallocate(pointer, size_type) { }
+
+        template<class U>
+        struct rebind {
+            typedef ArenaAllocator<U> other;
+        };
+
+        template<class U>
+        bool operator==(const ArenaAllocator<U> &other) const { return arena_ == other.arena_; }
+
+        template<class U>
+        bool operator!=(const ArenaAllocator<U> &other) const { return arena_ != other.arena_; }
+
+        /// Arena of the allocator.
+        Arena *arena_;
+    };
+}
+
+
+#endif /* ARENA_ALLOCATOR_HH_ */
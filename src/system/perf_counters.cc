@@ -0,0 +1,129 @@
+/*!
+ *
+ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    perf_counters.cc
+ * @brief   Hardware performance counters of the process.
+ */
+
+#include "system/perf_counters.hh"
+
+#ifdef __linux__
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+
+const char *PerfCounters::names[PerfCounters::n_counters] =
+    { "cycles", "instructions", "cache-misses", "branch-misses" };
+
+int PerfCounters::group_fd_ = -1;
+int PerfCounters::fds_[PerfCounters::n_counters] = { -1, -1, -1, -1 };
+
+
+#ifdef __linux__
+
+namespace {
+
+/// Open one hardware counter of the calling process in the group given by @p group_fd.
+int open_counter(unsigned long long config, int group_fd)
+{
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = (group_fd < 0 ? 1 : 0);   // the whole group is enabled through the leader
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+}
+
+
+bool PerfCounters::open()
+{
+    if (is_active()) return true;
+
+    static const unsigned long long configs[n_counters] = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES };
+
+    int leader = -1;
+    for (unsigned int i=0; i<n_counters; i++) {
+        fds_[i] = open_counter(configs[i], leader);
+        if (fds_[i] < 0) {
+            // not supported or not permitted, use no counters at all
+            for (unsigned int j=0; j<i; j++) {
+                ::close(fds_[j]);
+                fds_[j] = -1;
+            }
+            return false;
+        }
+        if (i == 0) leader = fds_[0];
+    }
+
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    group_fd_ = leader;
+    return true;
+}
+
+
+void PerfCounters::close()
+{
+    if (!is_active()) return;
+    ioctl(group_fd_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    for (unsigned int i=0; i<n_counters; i++) {
+        ::close(fds_[i]);
+        fds_[i] = -1;
+    }
+    group_fd_ = -1;
+}
+
+
+void PerfCounters::read(Values &values)
+{
+    // group read format: number of counters followed by their values
+    unsigned long long buf[1 + n_counters];
+    if (is_active() && ::read(group_fd_, buf, sizeof(buf)) == (ssize_t)sizeof(buf)) {
+        for (unsigned int i=0; i<n_counters; i++) values[i] = buf[1+i];
+    } else {
+        values.fill(0);
+    }
+}
+
+#else
+
+bool PerfCounters::open()
+{
+    return false;
+}
+
+
+void PerfCounters::close()
+{}
+
+
+void PerfCounters::read(Values &values)
+{
+    values.fill(0);
+}
+
+#endif // __linux__
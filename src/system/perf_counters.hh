@@ -0,0 +1,73 @@
+/*!
+ *
+ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    perf_counters.hh
+ * @brief   Hardware performance counters of the process.
+ */
+
+#ifndef PERF_COUNTERS_HH_
+#define PERF_COUNTERS_HH_
+
+#include <array>
+
+
+/**
+ * @brief Access to hardware performance counters through Linux perf_event_open.
+ *
+ * All counters are opened as one group (so they are scheduled together) for the calling
+ * process only (user space). The counters are used by Profiler timers if turned on
+ * by @p open(). Opening fails on other systems than Linux or if the kernel does not allow
+ * it (see /proc/sys/kernel/perf_event_paranoid); in such case @p is_active() stays false.
+ */
+class PerfCounters {
+public:
+    /// Measured events.
+    enum Counter {
+        cycles = 0,
+        instructions,
+        cache_misses,
+        branch_misses,
+        n_counters
+    };
+
+    /// Values of all counters.
+    typedef std::array<unsigned long long, n_counters> Values;
+
+    /// Names of the counters used in the profiler report.
+    static const char *names[n_counters];
+
+    /// Assumed size of the cache line used for bandwidth estimates.
+    static const unsigned int cache_line_size = 64;
+
+    /// Open and start counters, return true on success.
+    static bool open();
+
+    /// Stop and close counters.
+    static void close();
+
+    /// Return true if counters are open.
+    static inline bool is_active()
+    { return group_fd_ >= 0; }
+
+    /// Read actual values of counters. Set zeros if counters are not active.
+    static void read(Values &values);
+
+private:
+    /// File descriptor of the group leader, negative if not open.
+    static int group_fd_;
+    /// File descriptors of all counters.
+    static int fds_[n_counters];
+};
+
+
+#endif /* PERF_COUNTERS_HH_ */
@@ -0,0 +1,251 @@
+/*!
+ *
+ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    profiler_trace.cc
+ * @brief   Low overhead timeline recording of timer spans, exported in Chrome trace format.
+ */
+
+#include "system/profiler_trace.hh"
+#include "system/system.hh"
+#include "system/asserts.hh"
+#include "system/logger.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+
+const std::size_t ProfilerTrace::default_capacity;
+const unsigned int ProfilerTrace::max_depth;
+bool ProfilerTrace::enabled_ = false;
+std::vector<ProfilerTrace::Event> ProfilerTrace::events_;
+std::size_t ProfilerTrace::n_recorded_ = 0;
+ProfilerTrace::Span ProfilerTrace::stack_[ProfilerTrace::max_depth];
+unsigned int ProfilerTrace::depth_ = 0;
+std::int64_t ProfilerTrace::t0_ = 0;
+
+
+namespace {
+
+/// Write @p str as JSON string.
+void write_json_string(std::ostream &os, const char *str)
+{
+    os << '"';
+    for (const char *c = str; *c; ++c) {
+        switch (*c) {
+            case '"':  os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            case '\n': os << "\\n"; break;
+            case '\t': os << "\\t"; break;
+            default:
+                if ((unsigned char)(*c) < 0x20) os << ' ';
+                else os << *c;
+        }
+    }
+    os << '"';
+}
+
+/// Write time given in nanoseconds as microseconds (unit of the trace format).
+void write_us(std::ostream &os, std::int64_t ns)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.3f", ns / 1000.0);
+    os << buf;
+}
+
+}
+
+
+std::int64_t ProfilerTrace::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch() ).count() - t0_;
+}
+
+
+void ProfilerTrace::enable(std::size_t capacity)
+{
+    ASSERT(capacity > 0).error("Zero capacity of the trace buffer.\n");
+    events_.clear();
+    events_.shrink_to_fit();
+    events_.resize(capacity);
+    n_recorded_ = 0;
+    depth_ = 0;
+    t0_ = 0;
+    t0_ = now();
+    enabled_ = true;
+}
+
+
+void ProfilerTrace::disable()
+{
+    enabled_ = false;
+    events_.clear();
+    events_.shrink_to_fit();
+    n_recorded_ = 0;
+    depth_ = 0;
+}
+
+
+unsigned int ProfilerTrace::begin(const char *tag, const char *subtag)
+{
+    unsigned int depth = depth_;
+    if (depth_ < max_depth) {
+        Span &span = stack_[depth_];
+        span.tag = tag;
+        span.subtag = subtag;
+        span.start = now();
+    }
+    ++depth_;
+    return depth;
+}
+
+
+void ProfilerTrace::close_span(std::int64_t end_time)
+{
+    --depth_;
+    if (depth_ >= max_depth) return;
+
+    const Span &span = stack_[depth_];
+    Event &ev = events_[n_recorded_ % events_.size()];
+    ev.tag = span.tag;
+    ev.subtag = span.subtag;
+    ev.start = span.start;
+    ev.duration = end_time - span.start;
+    ++n_recorded_;
+}
+
+
+void ProfilerTrace::end(const char *tag)
+{
+    if (!enabled_) return;
+
+    // find the innermost open span with the tag, compare pointers first
+    unsigned int top = std::min(depth_, max_depth);
+    unsigned int i = top;
+    while (i > 0 && stack_[i-1].tag != tag && std::strcmp(stack_[i-1].tag, tag) != 0) --i;
+    if (i == 0) return;
+    // spans deeper than max_depth are closed as well
+    end_to_depth(i-1);
+}
+
+
+void ProfilerTrace::end_last()
+{
+    if (!enabled_ || depth_ == 0) return;
+    close_span( now() );
+}
+
+
+void ProfilerTrace::end_to_depth(unsigned int depth)
+{
+    if (!enabled_) return;
+    std::int64_t end_time = now();
+    while (depth_ > depth) close_span(end_time);
+}
+
+
+std::size_t ProfilerTrace::n_events()
+{
+    return std::min(n_recorded_, events_.size());
+}
+
+
+std::size_t ProfilerTrace::n_lost_events()
+{
+    return n_recorded_ - n_events();
+}
+
+
+const ProfilerTrace::Event &ProfilerTrace::event(std::size_t i)
+{
+    ASSERT_LT_DBG(i, n_events());
+    return events_[ (n_lost_events() + i) % events_.size() ];
+}
+
+
+void ProfilerTrace::output_events(std::ostream &os, int pid, std::int64_t shift)
+{
+    os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+       << ",\"tid\":0,\"args\":{\"name\":\"rank " << pid << "\"}}";
+    for (std::size_t i=0; i<n_events(); i++) {
+        const Event &ev = event(i);
+        os << ",\n{\"name\":";
+        write_json_string(os, ev.tag);
+        os << ",\"ph\":\"X\",\"ts\":";
+        write_us(os, ev.start + shift);
+        os << ",\"dur\":";
+        write_us(os, ev.duration);
+        os << ",\"pid\":" << pid << ",\"tid\":0";
+        if (ev.subtag != nullptr && ev.subtag[0] != 0) {
+            os << ",\"args\":{\"subtag\":";
+            write_json_string(os, ev.subtag);
+            os << "}";
+        }
+        os << "}";
+    }
+    if (n_lost_events() > 0)
+        os << ",\n{\"name\":\"lost_events\",\"ph\":\"C\",\"ts\":0,\"pid\":" << pid
+           << ",\"args\":{\"count\":" << n_lost_events() << "}}";
+}
+
+
+void ProfilerTrace::output(MPI_Comm comm, const std::string &file_name)
+{
+    if (!enabled_) return;
+    end_to_depth(0);
+
+    int mpi_initialized = 0, mpi_rank = 0, mpi_size = 1;
+    MPI_Initialized(&mpi_initialized);
+    if (mpi_initialized) {
+        chkerr(MPI_Comm_rank(comm, &mpi_rank));
+        chkerr(MPI_Comm_size(comm, &mpi_size));
+    }
+
+    // align clocks of the processes: shift to the time of rank 0 at the end of a barrier
+    std::int64_t shift = 0;
+    if (mpi_size > 1) {
+        chkerr(MPI_Barrier(comm));
+        long long local_time = now(), root_time = local_time;
+        chkerr(MPI_Bcast(&root_time, 1, MPI_LONG_LONG, 0, comm));
+        shift = root_time - local_time;
+    }
+
+    if (mpi_rank == 0) {
+        std::ofstream os(file_name.c_str());
+        // if the file can not be opened, still receive the data to not block other processes
+        if (!os.good()) WarningOut().fmt("Can not open trace file '{}'.\n", file_name);
+        os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        output_events(os, 0, shift);
+        // receive events of other processes one by one to limit memory of rank 0
+        for (int rank=1; rank<mpi_size; rank++) {
+            int size;
+            chkerr(MPI_Recv(&size, 1, MPI_INT, rank, 0, comm, MPI_STATUS_IGNORE));
+            std::vector<char> buf(size);
+            chkerr(MPI_Recv(buf.data(), size, MPI_CHAR, rank, 1, comm, MPI_STATUS_IGNORE));
+            os << ",\n";
+            os.write(buf.data(), size);
+        }
+        os << "\n]}\n";
+    } else {
+        std::ostringstream os;
+        output_events(os, mpi_rank, shift);
+        std::string str = os.str();
+        int size = str.size();
+        chkerr(MPI_Send(&size, 1, MPI_INT, 0, 0, comm));
+        chkerr(MPI_Send(const_cast<char *>(str.data()), size, MPI_CHAR, 0, 1, comm));
+    }
+}
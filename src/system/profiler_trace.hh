@@ -0,0 +1,158 @@
+/*!
+ *
+ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    profiler_trace.hh
+ * @brief   Low overhead timeline recording of timer spans, exported in Chrome trace format.
+ */
+
+#ifndef PROFILER_TRACE_HH_
+#define PROFILER_TRACE_HH_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <ostream>
+#include "petscsys.h"     // for MPI_Comm
+
+
+/**
+ * @brief Recorder of the timeline of timer spans.
+ *
+ * Unlike the Profiler, this class does not aggregate any call tree. Every closed
+ * START_TIMER / END_TIMER span is stored as one complete event (tag, start, duration)
+ * into a fixed size ring buffer allocated by @p enable(). With FLOW123D_DEBUG_PROFILER
+ * the spans are fed by Profiler::start_timer / Profiler::stop_timer, otherwise by TraceFrame
+ * created by the timer macros. Recording is turned on at runtime; when disabled, a timer
+ * costs one test of a static flag. When the buffer is full the oldest events are overwritten.
+ *
+ * The events of all MPI processes are written by @p output() into a single file in the
+ * Chrome trace event format (readable by chrome://tracing and Perfetto), one process
+ * per rank. Timestamps of the ranks are aligned at a barrier in @p output().
+ *
+ * Flow123d is single threaded, so there is one buffer per process and no locking.
+ * Tags must be string literals (as for the debug profiler), only the pointers are stored.
+ */
+class ProfilerTrace {
+public:
+    /// Default number of events kept in the ring buffer.
+    static const std::size_t default_capacity = 1 << 20;
+    /// Maximal depth of nested open spans; deeper spans are counted but not recorded.
+    static const unsigned int max_depth = 128;
+
+    /// Recorded span, times in nanoseconds.
+    struct Event {
+        const char *tag;
+        const char *subtag;
+        std::int64_t start;
+        std::int64_t duration;
+    };
+
+    /// Allocate buffer for @p capacity events and start recording.
+    static void enable(std::size_t capacity = default_capacity);
+
+    /// Stop recording and release all recorded data.
+    static void disable();
+
+    /// Return true if spans are recorded.
+    static inline bool is_enabled()
+    { return enabled_; }
+
+    /**
+     * Open a new span, return depth of the span stack before the call.
+     * @p subtag may be nullptr.
+     */
+    static unsigned int begin(const char *tag, const char *subtag = nullptr);
+
+    /**
+     * Close spans up to the innermost one with given @p tag (inclusive).
+     * Does nothing if there is no such open span.
+     */
+    static void end(const char *tag);
+
+    /// Close the innermost open span.
+    static void end_last();
+
+    /// Close all spans opened above given @p depth.
+    static void end_to_depth(unsigned int depth);
+
+    /// Number of events kept in the buffer.
+    static std::size_t n_events();
+
+    /// Number of events overwritten due to full buffer.
+    static std::size_t n_lost_events();
+
+    /// Return event @p i, the oldest kept event has index 0.
+    static const Event &event(std::size_t i);
+
+    /**
+     * Collective. Close all open spans and write events of all processes of @p comm
+     * to the file @p file_name (on rank 0).
+     */
+    static void output(MPI_Comm comm, const std::string &file_name);
+
+    /// Write events of this process as Chrome trace events with given @p pid, shifted by @p shift ns.
+    static void output_events(std::ostream &os, int pid, std::int64_t shift);
+
+private:
+    /// Open span.
+    struct Span {
+        const char *tag;
+        const char *subtag;
+        std::int64_t start;
+    };
+
+    /// Time in nanoseconds from @p enable().
+    static std::int64_t now();
+
+    /// Close the innermost open span at time @p end_time.
+    static void close_span(std::int64_t end_time);
+
+    /// Recording flag.
+    static bool enabled_;
+    /// Ring buffer of events.
+    static std::vector<Event> events_;
+    /// Total number of recorded events, next event is stored at n_recorded_ % capacity.
+    static std::size_t n_recorded_;
+    /// Stack of open spans.
+    static Span stack_[max_depth];
+    /// Number of open spans (may exceed max_depth).
+    static unsigned int depth_;
+    /// Time of @p enable() in nanoseconds of the steady clock.
+    static std::int64_t t0_;
+};
+
+
+/**
+ * RAII object created by the START_TIMER macro without FLOW123D_DEBUG_PROFILER.
+ * Opens a span if recording is enabled, closes it (and all spans opened inside)
+ * at the end of the block.
+ */
+class TraceFrame {
+public:
+    inline TraceFrame(const char *tag, const char *subtag = nullptr)
+    : depth_( ProfilerTrace::is_enabled() ? (int)ProfilerTrace::begin(tag, subtag) : -1 )
+    {}
+
+    inline ~TraceFrame()
+    { if (depth_ >= 0) ProfilerTrace::end_to_depth(depth_); }
+
+    TraceFrame(const TraceFrame &) = delete;
+    TraceFrame &operator=(const TraceFrame &) = delete;
+private:
+    /// Depth of the span stack before opening, -1 if nothing was opened.
+    const int depth_;
+};
+
+
+#endif /* PROFILER_TRACE_HH_ */
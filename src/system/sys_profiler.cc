@@ -127,6 +127,8 @@ Timer::Timer(const CodePoint &cp, int parent)
 #endif // FLOW123D_HAVE_PETSC
 {
     for(unsigned int i=0; i< max_n_childs ;i++)   child_timers[i]=timer_no_child;
+    perf_start_.fill(0);
+    perf_cumul_.fill(0);
 }
 
 
@@ -152,6 +154,16 @@ double Timer::cumulative_time() const {
     return cumul_time;
 }
 
+double Timer::perf_ipc() const {
+    if (perf_cumul_[PerfCounters::cycles] == 0) return 0.0;
+    return (double)perf_cumul_[PerfCounters::instructions] / perf_cumul_[PerfCounters::cycles];
+}
+
+double Timer::perf_bandwidth() const {
+    if (cumul_time < 1.0e-10) return 0.0;
+    return (double)perf_cumul_[PerfCounters::cache_misses] * PerfCounters::cache_line_size / cumul_time;
+}
+
 void Profiler::accept_from_child(Timer &parent, Timer &child) {
     int child_timer = 0;
     for (unsigned int i = 0; i < Timer::max_n_childs; i++) {
@@ -216,6 +228,7 @@ void Timer::start() {
     
     if (start_count == 0) {
         start_time = TimePoint();
+        if (PerfCounters::is_active()) PerfCounters::read(perf_start_);
     }
     call_count++;
     start_count++;
@@ -241,6 +254,12 @@ bool Timer::stop(bool forced) {
 
     if (start_count == 1) {
         cumul_time += (TimePoint() - start_time);
+        if (PerfCounters::is_active()) {
+            PerfCounters::Values perf_end;
+            PerfCounters::read(perf_end);
+            for (unsigned int i=0; i<PerfCounters::n_counters; i++)
+                perf_cumul_[i] += perf_end[i] - perf_start_[i];
+        }
         start_count--;
         return true;
     } else {
@@ -367,6 +386,7 @@ int  Profiler::start_timer(const CodePoint &cp) {
     timers_[parent_node].pause();
     
     timers_[actual_node].start();
+    if (ProfilerTrace::is_enabled()) ProfilerTrace::begin(cp.tag_, cp.subtag_);
     
     return actual_node;
 }
@@ -412,6 +432,7 @@ void Profiler::stop_timer(const CodePoint &cp) {
                 }
                 // close 'node' itself
                 timers_[actual_node].stop(false);
+                ProfilerTrace::end(cp.tag_);
                 actual_node = timers_[actual_node].parent_timer;
                 
                 // actual_node == child_timer indicates this is root
@@ -428,6 +449,7 @@ void Profiler::stop_timer(const CodePoint &cp) {
     }
     // node to close match the actual
     timers_[actual_node].stop(false);
+    ProfilerTrace::end(cp.tag_);
     actual_node = timers_[actual_node].parent_timer;
     
     // actual_node == child_timer indicates this is root
@@ -610,6 +632,10 @@ void Profiler::output(MPI_Comm comm, ostream &os) {
     chkerr( MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank) );
     MPI_Comm_size(comm, &mpi_size);
 
+    // report hardware counters only if they are measured on all processes
+    int local_perf_active = PerfCounters::is_active(), perf_active;
+    MPI_Allreduce(&local_perf_active, &perf_active, 1, MPI_INT, MPI_MIN, comm);
+
     // output header
     nlohmann::json jsonRoot, jsonChildren;
 
@@ -644,6 +670,17 @@ void Profiler::output(MPI_Comm comm, ostream &os) {
         save_mpi_metric<long>(node, comm, &petsc_memory_difference, "memory-petsc-diff");
         save_mpi_metric<long>(node, comm, &petsc_peak_memory, "memory-petsc-peak");
 #endif // FLOW123D_HAVE_PETSC
+
+        if (perf_active) {
+            for (unsigned int i=0; i<PerfCounters::n_counters; i++) {
+                long count = (long)timer.perf_cumul_[i];
+                save_mpi_metric<long>(node, comm, &count, string("perf-") + PerfCounters::names[i]);
+            }
+            double ipc = timer.perf_ipc();
+            double bandwidth = timer.perf_bandwidth();
+            save_mpi_metric<double>(node, comm, &ipc, "perf-ipc");
+            save_mpi_metric<double>(node, comm, &bandwidth, "perf-bandwidth");
+        }
         
         return MPI_Functions::sum(&cumul_time, comm);
     };
@@ -741,6 +778,17 @@ void Profiler::output(ostream &os) {
         save_nonmpi_metric<long>(node, &petsc_memory_difference, "memory-petsc-diff");
         save_nonmpi_metric<long>(node, &petsc_peak_memory, "memory-petsc-peak");
 #endif // FLOW123D_HAVE_PETSC
+
+        if (PerfCounters::is_active()) {
+            for (unsigned int i=0; i<PerfCounters::n_counters; i++) {
+                long count = (long)timer.perf_cumul_[i];
+                save_nonmpi_metric<long>(node, &count, string("perf-") + PerfCounters::names[i]);
+            }
+            double ipc = timer.perf_ipc();
+            double bandwidth = timer.perf_bandwidth();
+            save_nonmpi_metric<double>(node, &ipc, "perf-ipc");
+            save_nonmpi_metric<double>(node, &bandwidth, "perf-bandwidth");
+        }
         
         return cumul_time;
     };
@@ -867,6 +915,7 @@ void Profiler::uninitialize() {
     			.error("Forbidden to uninitialize the Profiler when actual timer is not zero.");
         Profiler::instance()->stop_timer(0);
         set_memory_monitoring(false, false);
+        PerfCounters::close();
         Profiler::instance(true);
     }
 }
@@ -877,6 +926,15 @@ void Profiler::set_memory_monitoring(const bool global_monitor, const bool petsc
     petsc_monitor_memory = petsc_monitor;
 }
 
+void Profiler::set_perf_counters(const bool use_counters) {
+    if (use_counters) {
+        if (!PerfCounters::open())
+            WarningOut() << "Hardware performance counters are not available, profiler will not report them." << std::endl;
+    } else {
+        PerfCounters::close();
+    }
+}
+
 bool Profiler::get_global_memory_monitoring() {
     return global_monitor_memory;
 }
@@ -64,6 +64,8 @@ namespace boost { template <class T> struct hash; }
 #include "time_point.hh"
 #include "petscsys.h" 
 #include "simple_allocator.hh"
+#include "profiler_trace.hh"
+#include "perf_counters.hh"
 
 //instead of #include "mpi.h"
 //mpi declarations follows:
@@ -104,6 +106,10 @@ using namespace std;
  * calls @p Profiler::start_timer() in constructor and @p Profiler::stop_timer() in destructor.
  * This way the timer is automatically closed at the end of current block.
  *
+ * If the recording of ProfilerTrace is enabled at runtime, the span is recorded into its timeline
+ * (by @p Profiler::start_timer() / @p Profiler::stop_timer() or, without FLOW123D_DEBUG_PROFILER,
+ * by a TraceFrame that the macro creates instead of the TimerFrame).
+ *
  * ATTENTION: This macro expands to two statements so following code is illegal:
  * @code
  *      if (some_condition) START_TIMER(tag);
@@ -112,7 +118,7 @@ using namespace std;
 #ifdef FLOW123D_DEBUG_PROFILER
 #define START_TIMER(tag) static CONSTEXPR_ CodePoint PASTE(cp_,__LINE__) = CODE_POINT(tag); TimerFrame PASTE(timer_,__LINE__) = TimerFrame( PASTE(cp_,__LINE__) )
 #else
-#define START_TIMER(tag)
+#define START_TIMER(tag) TraceFrame PASTE(timer_,__LINE__)(tag)
 #endif
 
 /**
@@ -133,7 +139,7 @@ using namespace std;
 #ifdef FLOW123D_DEBUG_PROFILER
 #define START_TIMER_EXT(tag, subtag) static CONSTEXPR_ CodePoint PASTE(cp_,__LINE__) = CODE_POINT_EXT(tag, subtag); TimerFrame PASTE(timer_,__LINE__) = TimerFrame( PASTE(cp_,__LINE__) )
 #else
-#define START_TIMER_EXT(tag, subtag)
+#define START_TIMER_EXT(tag, subtag) TraceFrame PASTE(timer_,__LINE__)(tag, subtag)
 #endif
 
 /**
@@ -146,7 +152,7 @@ using namespace std;
 #ifdef FLOW123D_DEBUG_PROFILER
 #define END_TIMER(tag) static CONSTEXPR_ CodePoint PASTE(cp_,__LINE__) = CODE_POINT(tag); Profiler::instance()->stop_timer( PASTE(cp_,__LINE__) )
 #else
-#define END_TIMER(tag)
+#define END_TIMER(tag) ProfilerTrace::end(tag)
 #endif
 
 /**
@@ -157,7 +163,7 @@ using namespace std;
 #ifdef FLOW123D_DEBUG_PROFILER
 #define END_START_TIMER(tag) Profiler::instance()->stop_timer(); START_TIMER(tag);
 #else
-#define END_START_TIMER(tag)
+#define END_START_TIMER(tag) ProfilerTrace::end_last(); START_TIMER(tag);
 #endif
 
 
@@ -333,6 +339,12 @@ public:
      */
     double cumulative_time() const;
 
+    /// Returns instructions per cycle measured by hardware counters, zero if not measured.
+    double perf_ipc() const;
+
+    /// Returns memory bandwidth estimate (bytes/s) from the number of cache misses, zero if not measured.
+    double perf_bandwidth() const;
+
     /*
      * Adds given index @p child_index of the timer @p child to the correct place in the hash table.
      */
@@ -453,6 +465,16 @@ protected:
      */
     PetscLogDouble petsc_local_peak_memory;
     #endif // FLOW123D_HAVE_PETSC
+
+    /**
+     * Values of hardware counters when the frame opens.
+     */
+    PerfCounters::Values perf_start_;
+    /**
+     * Cumulative values of hardware counters in the frame. As the cumulative time,
+     * they include values of children.
+     */
+    PerfCounters::Values perf_cumul_;
     
     friend class Profiler;
     friend std::ostream & operator <<(std::ostream&, const Timer&);
@@ -660,6 +682,13 @@ public:
      * @return memory monitoring status
      */
     bool static get_global_memory_monitoring();
+
+    /**
+     * Turn on/off hardware performance counters in timers. Counters are not used if they
+     * can not be opened (not Linux, insufficient permissions).
+     * Timers running at the time of the call are not measured correctly.
+     */
+    void static set_perf_counters(const bool use_counters);
     
     /**
      * Public getter to petsc memory monitoring
@@ -860,6 +889,8 @@ public:
     {}
     void transform_profiler_data(const string &, const string &)
     {}
+    static void set_perf_counters(const bool)
+    {}
     double get_resolution () const
     { return 0.0; }
     const char *actual_tag() const
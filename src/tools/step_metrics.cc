@@ -0,0 +1,137 @@
+/*!
+ *
+ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    step_metrics.cc
+ * @brief   Per time step performance metrics of equations.
+ */
+
+#include "tools/step_metrics.hh"
+#include "system/system.hh"
+#include "system/file_path.hh"
+#include "system/logger.hh"
+
+#include <chrono>
+#include <cmath>
+#include <sys/resource.h>
+
+
+namespace {
+
+/// JSON value of a time, infinite times (steady problems) are written as null.
+std::string json_time(double t)
+{
+    return std::isfinite(t) ? fmt::format("{}", t) : std::string("null");
+}
+
+}
+
+
+bool StepMetrics::active_ = false;
+std::string StepMetrics::file_name_ = "";
+std::ofstream StepMetrics::stream_;
+
+
+StepMetrics::PhaseTimer::PhaseTimer(StepMetrics &metrics, Phase phase)
+: metrics_(metrics),
+  phase_(phase),
+  start_(0.0),
+  running_(StepMetrics::is_active())
+{
+    if (running_) start_ = StepMetrics::now();
+}
+
+
+void StepMetrics::PhaseTimer::stop()
+{
+    if (!running_) return;
+    metrics_.add_time(phase_, StepMetrics::now() - start_);
+    running_ = false;
+}
+
+
+void StepMetrics::set_file(const std::string &file_name)
+{
+    file_name_ = file_name;
+    active_ = true;
+}
+
+
+double StepMetrics::now()
+{
+    return std::chrono::duration<double>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+
+StepMetrics::StepMetrics()
+{
+    reset();
+}
+
+
+void StepMetrics::reset()
+{
+    for (unsigned int i=0; i<n_phases; i++) phase_time_[i] = 0.0;
+    n_linear_solves_ = 0;
+    n_linear_iterations_ = 0;
+    n_nonlinear_iterations_ = 0;
+    step_start_ = now();
+}
+
+
+void StepMetrics::write_step(const std::string &eq_name, int step, double t, double dt)
+{
+    if (!active_) return;
+
+    // wall time, phase times, peak RSS
+    const unsigned int n_values = n_phases + 2;
+    double local[n_values], max[n_values], sum[n_values];
+    local[0] = now() - step_start_;
+    for (unsigned int i=0; i<n_phases; i++) local[1+i] = phase_time_[i];
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    local[n_phases+1] = usage.ru_maxrss;    // kB on Linux
+
+    int rank, size;
+    chkerr(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+    chkerr(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+    chkerr(MPI_Reduce(local, max, n_values, MPI_DOUBLE, MPI_MAX, 0, PETSC_COMM_WORLD));
+    chkerr(MPI_Reduce(local, sum, n_values, MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD));
+
+    if (rank == 0) {
+        // other processes keep reducing even if the file can not be opened
+        static bool open_tried = false;
+        if (!open_tried) {
+            open_tried = true;
+            try {
+                FilePath(file_name_, FilePath::output_file).open_stream(stream_);
+            } catch (FilePath::ExcFileOpen &) {
+                WarningOut() << "Can not open step metrics file, metrics are not written.\n";
+            }
+        }
+        if (stream_.is_open()) {
+            static const char *phase_names[n_phases] = { "assembly", "solve", "output" };
+            double wall_avg = sum[0] / size;
+            stream_ << fmt::format("{{\"equation\":\"{}\",\"step\":{},\"time\":{},\"dt\":{},\"wall_max\":{},\"wall_avg\":{}",
+                    eq_name, step, json_time(t), json_time(dt), max[0], wall_avg);
+            for (unsigned int i=0; i<n_phases; i++)
+                stream_ << fmt::format(",\"{0}_max\":{1},\"{0}_avg\":{2}", phase_names[i], max[1+i], sum[1+i] / size);
+            stream_ << fmt::format(",\"linear_solves\":{},\"linear_iterations\":{},\"nonlinear_iterations\":{}",
+                    n_linear_solves_, n_linear_iterations_, n_nonlinear_iterations_);
+            stream_ << fmt::format(",\"peak_rss_max_kb\":{},\"imbalance\":{}}}\n",
+                    (long)max[n_phases+1], (wall_avg > 0.0 ? max[0] / wall_avg : 1.0));
+            // keep the file up to date for monitoring of running jobs
+            stream_.flush();
+        }
+    }
+    reset();
+}
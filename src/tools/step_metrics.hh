@@ -0,0 +1,130 @@
+/*!
+ *
+ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    step_metrics.hh
+ * @brief   Per time step performance metrics of equations.
+ */
+
+#ifndef STEP_METRICS_HH_
+#define STEP_METRICS_HH_
+
+#include <string>
+#include <fstream>
+
+
+/**
+ * @brief Collects performance metrics of one time step of an equation.
+ *
+ * Every TimeGovernor has one StepMetrics object. The equation adds times of its phases
+ * (assembly, linear solver, output) and numbers of linear and nonlinear iterations during
+ * the step. TimeGovernor::next_time() then calls @p write_step() that reduces the metrics
+ * over all processes and writes one row of the metrics stream (JSON lines) on rank 0.
+ *
+ * The stream is global for all equations and is turned on by @p set_file(). If it is not
+ * set, all methods return immediately.
+ *
+ * Columns of a row: equation, step, time, dt, wall time of the step, times of the phases
+ * (maximum and average over processes), numbers of linear solves, linear and nonlinear
+ * iterations, peak resident set size (maximum over processes, kB) and imbalance of the
+ * wall time (maximum / average).
+ */
+class StepMetrics {
+public:
+    /// Measured phases of a time step.
+    enum Phase {
+        assembly = 0,
+        solve,
+        output,
+        n_phases
+    };
+
+    /// Measures time of a phase from construction to @p stop() or destruction.
+    class PhaseTimer {
+    public:
+        PhaseTimer(StepMetrics &metrics, Phase phase);
+
+        ~PhaseTimer()
+        { stop(); }
+
+        /// Add elapsed time to the phase, does nothing if already stopped.
+        void stop();
+
+    private:
+        StepMetrics &metrics_;
+        Phase phase_;
+        double start_;
+        bool running_;
+    };
+
+    /**
+     * Turn on the metrics stream. The file (relative to the output directory) is opened
+     * on rank 0 by the first @p write_step(), so this can be called before MPI initialization.
+     */
+    static void set_file(const std::string &file_name);
+
+    /// Return true if the metrics stream is turned on.
+    static inline bool is_active()
+    { return active_; }
+
+    /// Constructor, starts the first step.
+    StepMetrics();
+
+    /// Add @p seconds to the time of @p phase.
+    inline void add_time(Phase phase, double seconds)
+    { phase_time_[phase] += seconds; }
+
+    /// Register one solve of a linear system that took @p n_iterations.
+    inline void add_linear_solve(int n_iterations)
+    {
+        n_linear_solves_++;
+        n_linear_iterations_ += n_iterations;
+    }
+
+    /// Register @p n nonlinear iterations.
+    inline void add_nonlinear_iterations(unsigned int n = 1)
+    { n_nonlinear_iterations_ += n; }
+
+    /**
+     * Collective. Write metrics of the finished step of equation @p eq_name with given @p step index,
+     * end time @p t and length @p dt. Start the next step.
+     */
+    void write_step(const std::string &eq_name, int step, double t, double dt);
+
+    /// Wall clock time in seconds.
+    static double now();
+
+private:
+    /// Reset metrics of the step.
+    void reset();
+
+    /// Times of phases in the step.
+    double phase_time_[n_phases];
+    /// Number of linear solves in the step.
+    unsigned int n_linear_solves_;
+    /// Total number of linear iterations in the step.
+    unsigned int n_linear_iterations_;
+    /// Number of nonlinear iterations in the step.
+    unsigned int n_nonlinear_iterations_;
+    /// Start time of the step.
+    double step_start_;
+
+    /// True if metrics are written.
+    static bool active_;
+    /// Name of the metrics file.
+    static std::string file_name_;
+    /// Metrics stream, open only on rank 0.
+    static std::ofstream stream_;
+};
+
+
+#endif /* STEP_METRICS_HH_ */
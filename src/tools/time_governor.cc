@@ -367,6 +367,12 @@ TimeGovernor::TimeGovernor(double init_time, TimeMark::Type eq_mark_type)
 
 TimeGovernor::~TimeGovernor()
 {
+    // metrics of the last step, destructor is called on all processes
+    int mpi_finalized = 0;
+    MPI_Finalized(&mpi_finalized);
+    if (StepMetrics::is_active() && !mpi_finalized)
+        metrics_.write_step(metrics_name_, tlevel(), t(), dt());
+
 	if ( !(timesteps_output_file_ == FilePath()) && timestep_output_ ) {
 		timesteps_output_.close();
 	}
@@ -376,6 +382,7 @@ TimeGovernor::~TimeGovernor()
 // common part of constructors
 void TimeGovernor::init_common(double init_time, double end_time, TimeMark::Type type)
 {
+    metrics_name_ = "TG";
 
     if (init_time < 0.0) {
 		THROW(ExcTimeGovernorMessage()
@@ -641,6 +648,9 @@ void TimeGovernor::next_time()
 {
     OLD_ASSERT_LE(0.0, t());
     if (is_end()) return;
+
+    // metrics of the finished step
+    metrics_.write_step(metrics_name_, tlevel(), t(), dt());
     
 
     if (this->step().lt(end_of_fixed_dt_interval_)) {
@@ -741,6 +751,7 @@ const TimeStep &TimeGovernor::step(int index) const {
 
 void TimeGovernor::view(const char *name) const
 {
+    metrics_name_ = name;
 #ifdef FLOW123D_DEBUG_MESSAGES
     MessageOut().fmt(
             "TG[{}]:{:06d}    t:{:10.4f}    dt:{:10.6f}    dt_int<{:10.6f},{:10.6f}>    "
@@ -36,6 +36,7 @@
 #include "system/exc_common.hh"
 #include "system/exceptions.hh"
 #include "tools/time_marks.hh"
+#include "tools/step_metrics.hh"
 
 namespace Input {
     class Record;
@@ -591,6 +592,13 @@ public:
      */
     void view(const char *name="") const;
 
+    /**
+     * Performance metrics of the actual time step. The equation adds times of its phases
+     * and iteration counts, the metrics are written by next_time().
+     */
+    inline StepMetrics &metrics()
+        { return metrics_; }
+
     /**
      * Read and return time value multiplied by coefficient of given unit or global coefficient of equation
      * stored in time_unit_conversion_. If time Tuple is not defined (e. g. Tuple is optional key) return
@@ -734,6 +742,12 @@ private:
     /// Allows add all times defined in dt_limits_table_ to list of TimeMarks
     bool limits_time_marks_;
 
+    /// Performance metrics of the actual time step.
+    StepMetrics metrics_;
+
+    /// Name of the equation used in metrics, the last name passed to view().
+    mutable std::string metrics_name_;
+
     friend TimeMarks;
 };
 
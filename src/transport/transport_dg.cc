@@ -89,6 +89,9 @@ const Record & TransportDG<Model>::get_input_type() {
                 "Variant of the interior penalty discontinuous Galerkin method.")
         .declare_key("dg_order", Integer(0,3), Default("1"),
                 "Polynomial order for the finite element in DG method (order 0 is suitable if there is no diffusion/dispersion).")
+        .declare_key("share_solver", Bool(), Default("true"),
+                "Substances with identical matrices of the linear system are solved by a single solver "
+                "with a common preconditioner.")
         .declare_key("output",
                 EqData().output_fields.make_output_type(equation_name, ""),
                 IT::Default("{ \"fields\": [ " + Model::ModelEqData::default_output_field() + "] }"),
@@ -219,6 +222,7 @@ TransportDG<Model>::TransportDG(Mesh & init_mesh, const Input::Record in_rec)
     // DG variant and order
     data_->dg_variant = in_rec.val<DGVariant>("dg_variant");
     data_->dg_order = in_rec.val<unsigned int>("dg_order");
+    share_solver_ = in_rec.val<bool>("share_solver");
     
     Model::init_from_input(in_rec);
 
@@ -313,8 +317,12 @@ void TransportDG<Model>::initialize()
     stiffness_matrix.resize(Model::n_substances(), nullptr);
     mass_matrix.resize(Model::n_substances(), nullptr);
     rhs.resize(Model::n_substances(), nullptr);
+    sources_rhs.resize(Model::n_substances(), nullptr);
     mass_vec.resize(Model::n_substances(), nullptr);
     data_->ret_vec.resize(Model::n_substances(), nullptr);
+    shared_ls_.resize(Model::n_substances());
+    for (unsigned int sbi = 0; sbi < Model::n_substances(); sbi++) shared_ls_[sbi] = sbi;
+    matrix_fingerprint_.resize(Model::n_substances(), 0.0);
 
     for (unsigned int sbi = 0; sbi < Model::n_substances(); sbi++) {
     	data_->ls[sbi] = new LinSys_PETSC(data_->dh_->distr().get(), petsc_default_opts);
@@ -371,6 +379,8 @@ TransportDG<Model>::~TransportDG()
                 chkerr(MatDestroy(&mass_matrix[i]));
             if (rhs[i])
             	chkerr(VecDestroy(&rhs[i]));
+            if (sources_rhs[i])
+            	chkerr(VecDestroy(&sources_rhs[i]));
             if (mass_vec[i])
             	chkerr(VecDestroy(&mass_vec[i]));
             if (data_->ret_vec[i])
@@ -477,10 +487,16 @@ void TransportDG<Model>::update_solution()
     START_TIMER("data reinit");
     data_->set_time(Model::time_->step(), LimitSide::left);
     END_TIMER("data reinit");
+
+    StepMetrics::PhaseTimer assembly_timer(Model::time_->metrics(), StepMetrics::assembly);
     
+    // true if the matrix of the linear system has to be recomputed
+    bool ls_matrix_changed = Model::time_->is_changed_dt();
+
     // assemble mass matrix
     if (mass_matrix[0] == NULL || data_->subset(FieldFlag::in_time_term).changed() )
     {
+        ls_matrix_changed = true;
         for (unsigned int i=0; i<Model::n_substances(); i++)
         {
         	data_->ls_dt[i]->start_add_assembly();
@@ -514,6 +530,7 @@ void TransportDG<Model>::update_solution()
     {
         // new fluxes can change the location of Neumann boundary,
         // thus stiffness matrix must be reassembled
+        ls_matrix_changed = true;
         for (unsigned int i=0; i<Model::n_substances(); i++)
         {
             data_->ls[i]->start_add_assembly();
@@ -534,18 +551,34 @@ void TransportDG<Model>::update_solution()
     }
 
     // assemble right hand side (due to sources and boundary conditions)
-    if (rhs[0] == NULL
-            || data_->subset(FieldFlag::in_rhs).changed()
-            || data_->flow_flux.changed())
+    // If the data changed only on boundary regions, the part due to sources is reused.
+    FieldSet rhs_fields = data_->subset(FieldFlag::in_rhs);
+    bool sources_changed = (rhs[0] == NULL)
+            || data_->flow_flux.changed()
+            || rhs_fields.changed( Model::mesh_->region_db().get_region_set("BULK") );
+    if (sources_changed || rhs_fields.changed())
     {
         for (unsigned int i=0; i<Model::n_substances(); i++)
         {
             data_->ls[i]->start_add_assembly();
             data_->ls[i]->rhs_zero_entries();
         }
-        START_TIMER("assemble_sources");
-        data_->sources_assembly_->assemble(data_->dh_);
-        END_TIMER("assemble_sources");
+        if (sources_changed)
+        {
+            START_TIMER("assemble_sources");
+            data_->sources_assembly_->assemble(data_->dh_);
+            END_TIMER("assemble_sources");
+            for (unsigned int i=0; i<Model::n_substances(); i++)
+            {
+                data_->ls[i]->finish_assembly();
+
+                if (sources_rhs[i] == nullptr) VecDuplicate(*( data_->ls[i]->get_rhs() ), &sources_rhs[i]);
+                VecCopy(*( data_->ls[i]->get_rhs() ), sources_rhs[i]);
+
+                data_->ls[i]->start_add_assembly();
+                data_->ls[i]->rhs_zero_entries();
+            }
+        }
         START_TIMER("assemble_bc");
         data_->bdr_cond_assembly_->assemble(data_->dh_);
         END_TIMER("assemble_bc");
@@ -554,7 +587,7 @@ void TransportDG<Model>::update_solution()
             data_->ls[i]->finish_assembly();
 
             if (rhs[i] == nullptr) VecDuplicate(*( data_->ls[i]->get_rhs() ), &rhs[i]);
-            VecCopy(*( data_->ls[i]->get_rhs() ), rhs[i]);
+            VecWAXPY(rhs[i], 1.0, sources_rhs[i], *( data_->ls[i]->get_rhs() ));
         }
     }
 
@@ -574,27 +607,67 @@ void TransportDG<Model>::update_solution()
     *
     *   A^k = A + 1/dt M.
     *
+    * If neither A, M nor dt changed, the matrix A^k from the previous step is kept
+    * in the linear system, so that its solver can reuse the preconditioner.
+    *
+    * Substances with identical A^k (typically without retardation and with equal diffusivity)
+    * are solved by the solver of the first such substance, reusing its preconditioner.
     */
     Mat m;
+    assembly_timer.stop();
     START_TIMER("solve");
+    StepMetrics::PhaseTimer solve_timer(Model::time_->metrics(), StepMetrics::solve);
     for (unsigned int i=0; i<Model::n_substances(); i++)
     {
-        MatConvert(stiffness_matrix[i], MATSAME, MAT_INITIAL_MATRIX, &m);
-        MatAXPY(m, 1./Model::time_->dt(), mass_matrix[i], SUBSET_NONZERO_PATTERN);
-        data_->ls[i]->set_matrix(m, DIFFERENT_NONZERO_PATTERN);
+        if (ls_matrix_changed)
+        {
+            MatConvert(stiffness_matrix[i], MATSAME, MAT_INITIAL_MATRIX, &m);
+            MatAXPY(m, 1./Model::time_->dt(), mass_matrix[i], SUBSET_NONZERO_PATTERN);
+
+            shared_ls_[i] = i;
+            if (share_solver_)
+            {
+                // Cheap fingerprint of the matrix, the full comparison is done only for matrices
+                // with equal fingerprints, so that substances with different matrices cost O(n_subst).
+                chkerr(MatNorm(m, NORM_FROBENIUS, &matrix_fingerprint_[i]));
+                for (unsigned int j=0; j<i; j++)
+                {
+                    if (shared_ls_[j] != j || matrix_fingerprint_[j] != matrix_fingerprint_[i]) continue;
+                    PetscBool equal;
+                    chkerr(MatEqual(m, *( data_->ls[j]->get_matrix() ), &equal));
+                    if (equal)
+                    {
+                        shared_ls_[i] = j;
+                        break;
+                    }
+                }
+            }
+            if (shared_ls_[i] == i)
+                data_->ls[i]->set_matrix(m, DIFFERENT_NONZERO_PATTERN);
+            chkerr(MatDestroy(&m));
+        }
         Vec w;
         VecDuplicate(rhs[i], &w);
         VecWAXPY(w, 1./Model::time_->dt(), mass_vec[i], rhs[i]);
-        data_->ls[i]->set_rhs(w);
 
-        VecDestroy(&w);
-        chkerr(MatDestroy(&m));
+        if (shared_ls_[i] == i)
+        {
+            data_->ls[i]->set_rhs(w);
+            LinSys::SolveInfo si = data_->ls[i]->solve();
+            Model::time_->metrics().add_linear_solve(si.n_iterations);
+        }
+        else
+        {
+            LinSys::SolveInfo si = ( (LinSys_PETSC *)data_->ls[ shared_ls_[i] ] )->solve(w, data_->ls[i]->get_solution());
+            Model::time_->metrics().add_linear_solve(si.n_iterations);
+        }
 
-        data_->ls[i]->solve();
+        VecDestroy(&w);
 
         // update mass_vec due to possible changes in mass matrix
         MatMult(*(data_->ls_dt[i]->get_matrix()), data_->ls[i]->get_solution(), mass_vec[i]);
     }
+    solve_timer.stop();
     END_TIMER("solve");
 
     calculate_cumulative_balance();
@@ -637,6 +710,7 @@ void TransportDG<Model>::output_data()
 
 
     START_TIMER("DG-OUTPUT");
+    StepMetrics::PhaseTimer metrics_timer(Model::time_->metrics(), StepMetrics::output);
 
     // gather the solution from all processors
     data_->output_fields.set_time( this->time().step(), LimitSide::left);
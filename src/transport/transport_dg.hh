@@ -368,6 +368,9 @@ private:
 	/// Vector of right hand side.
 	std::vector<Vec> rhs;
 
+	/// Part of the right hand side due to volume sources, reused when only boundary data change.
+	std::vector<Vec> sources_rhs;
+
 	/// The stiffness matrix.
 	std::vector<Mat> stiffness_matrix;
 
@@ -376,6 +379,15 @@ private:
 	
 	/// Mass from previous time instant (necessary when coefficients of mass matrix change in time).
 	std::vector<Vec> mass_vec;
+
+	/// Index of the substance whose solver is used for the substance (equal to own index if not shared).
+	std::vector<unsigned int> shared_ls_;
+
+	/// Frobenius norms of the system matrices, used to preselect candidates for sharing the solver.
+	std::vector<double> matrix_fingerprint_;
+
+	/// Substances with identical matrices share the solver.
+	bool share_solver_;
 	// @}
 
 
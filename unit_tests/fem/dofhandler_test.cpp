@@ -57,6 +57,16 @@ TEST(DOFHandler, test_all) {
 
     // dof at node 1 is shared by elements 2, 3
     if (own_elem[1] & own_elem[2]) EXPECT_EQ( indices[1][0], indices[2][0] );
+
+    // own cells are split into interior and interface cells
+    EXPECT_EQ( dh.own_size(), dh.own_interior_cells().size() + dh.own_interface_cells().size() );
+    for (unsigned int loc_idx : dh.own_interior_cells())
+    {
+        LocDofVec loc_dofs = DHCellAccessor(&dh, loc_idx).get_loc_dof_indices();
+        for (unsigned int i=0; i<loc_dofs.n_elem; i++)
+            EXPECT_LT( loc_dofs[i], (int)dh.lsize() );
+    }
+    if (dh.distr()->np() == 1) EXPECT_EQ( 0, dh.own_interface_cells().size() );
     
     // dof at node 2 is shared by elements 2, 4
     if (own_elem[1] & own_elem[3]) EXPECT_EQ( indices[1][1], indices[3][1] );
@@ -242,6 +252,49 @@ TEST(DOFHandler, test_sub_handler)
 
 
 
+// coordinates of P1 dofs are nodes of the elements,
+// rigid body modes of vector P1 dofs are given by dof components and node coordinates
+TEST(DOFHandler, test_dof_coordinates)
+{
+    FilePath::set_io_dirs(".",UNIT_TESTS_SRC_DIR,"",".");
+    Mesh * mesh = mesh_full_constructor("{mesh_file=\"fem/small_mesh.msh\"}");
+
+    MixedPtr<FE_P> fe_p(1);
+    MixedPtr<FESystem> fe_vec = mixed_fe_system(fe_p, FEVector, 3);
+    std::shared_ptr<DiscreteSpace> ds = std::make_shared<EqualOrderDiscreteSpace>(mesh, fe_vec);
+    DOFHandlerMultiDim dh(*mesh);
+    dh.distribute_dofs(ds);
+
+    std::vector<double> coords = dh.own_dof_coordinates();
+    EXPECT_EQ( 3*dh.lsize(), coords.size() );
+    std::vector<VectorMPI> modes = dh.rigid_body_modes();
+    EXPECT_EQ( 6, modes.size() );
+
+    for (auto cell : dh.own_range())
+    {
+        LocDofVec loc_dofs = cell.get_loc_dof_indices();
+        for (unsigned int i=0; i<cell.n_dofs(); i++)
+        {
+            if (loc_dofs[i] >= (int)dh.lsize()) continue;
+            // dofs of FEVector are ordered by components
+            arma::vec3 node = *cell.elm().node(i % (cell.dim()+1));
+            unsigned int comp = i / (cell.dim()+1);
+            for (unsigned int c=0; c<3; c++)
+            {
+                EXPECT_DOUBLE_EQ( node[c], coords[3*loc_dofs[i]+c] );
+                EXPECT_DOUBLE_EQ( (c == comp) ? 1.0 : 0.0, modes[c][ loc_dofs[i] ] );
+            }
+            // rotation about z axis: u = (-y, x, 0)
+            double rot_z[3] = { -node[1], node[0], 0.0 };
+            EXPECT_DOUBLE_EQ( rot_z[comp], modes[5][ loc_dofs[i] ] );
+        }
+    }
+
+    delete mesh;
+}
+
+
+
 // distribute dofs for continuous RT0 finite element.
 // The test checks that the dofs are
 // shared by adjacent elements
@@ -7,9 +7,11 @@
 
 
 
+#define TEST_USE_PETSC
 #define FEAL_OVERRIDE_ASSERTS
 
-#include <flow_gtest.hh>
+#include <flow_gtest_mpi.hh>
+#include <mesh_constructor.hh>
 #include <string>
 #include <cmath>
 
@@ -26,6 +28,17 @@
 #include "input/input_type.hh"
 #include "input/accessors.hh"
 #include "input/reader_to_storage.hh"
+#include "fields/eval_points.hh"
+#include "fields/eval_subset.hh"
+#include "fields/field_value_cache.hh"
+#include "fields/field_value_cache.impl.hh"
+#include "quadrature/quadrature_lib.hh"
+#include "fem/dofhandler.hh"
+#include "fem/dh_cell_accessor.hh"
+#include "fem/mapping_p1.hh"
+#include "mesh/mesh.h"
+#include "mesh/ref_element.hh"
+#include "system/sys_profiler.hh"
 
 using namespace std;
 
@@ -49,6 +62,13 @@ def func_circle(r,phi,n):
     return ( r * math.cos(phi), r * math.sin(phi), 1 )
 )CODE";
 
+string python_batch_function = R"CODE(
+import array
+
+def func_xyz_batch(points):
+    return array.array('d', [ x*y*z for x,y,z in points.tolist() ])
+)CODE";
+
 string python_call_object_err = R"CODE(
 import math
 
@@ -131,6 +151,77 @@ TEST(FieldPython, double_3D) {
 }
 
 
+TEST(FieldPython, batch_3D) {
+    Armor::array point_list(3, 1, 2);
+    point_list.resize(2);
+    point_list.set(0) = arma::vec3("1 0 0");
+    point_list.set(1) = arma::vec3("1 2 3");
+    std::vector<double> value_list(2);
+
+    ElementAccessor<3> elm;
+    FieldPython<3, FieldValue<3>::Scalar> scalar_func;
+    scalar_func.set_python_field_from_string(python_batch_function, "func_xyz_batch", true);
+    scalar_func.value_list(point_list, elm, value_list);
+
+    EXPECT_EQ( 0, value_list[0]);
+    EXPECT_EQ( 6, value_list[1]);
+}
+
+
+TEST(FieldPython, cache_update) {
+    FilePath::set_io_dirs(".",UNIT_TESTS_SRC_DIR,"",".");
+    Profiler::instance();
+
+    Mesh * mesh = mesh_full_constructor("{mesh_file=\"mesh/cube_2x1.msh\"}");
+    std::shared_ptr<DOFHandlerMultiDim> dh = std::make_shared<DOFHandlerMultiDim>(*mesh);
+
+    std::shared_ptr<EvalPoints> eval_points = std::make_shared<EvalPoints>();
+    QGauss q_bulk(3, 2);
+    std::shared_ptr<BulkIntegral> mass_eval = eval_points->add_bulk<3>(q_bulk);
+    unsigned int subset_idx = mass_eval->get_subset_idx();
+    ElementCacheMap elm_cache_map;
+    elm_cache_map.init(eval_points);
+
+    // same function evaluated in batch mode and point by point
+    FieldPython<3, FieldValue<3>::Scalar> batch_func, point_func;
+    batch_func.set_python_field_from_string(python_batch_function, "func_xyz_batch", true);
+    point_func.set_python_field_from_string(python_function, "func_xyz");
+    batch_func.set_mesh(mesh, false);
+    point_func.set_mesh(mesh, false);
+    FieldValueCache<double> batch_cache(1, 1), point_cache(1, 1);
+    batch_cache.init(eval_points, ElementCacheMap::n_cached_elements);
+    point_cache.init(eval_points, ElementCacheMap::n_cached_elements);
+
+    // more elements in cache, so points of all of them are collected in one list
+    std::vector<unsigned int> cell_idx = {3, 4, 5, 9};
+    elm_cache_map.start_elements_update();
+    for (unsigned int i : cell_idx)
+        elm_cache_map.add( DHCellAccessor(dh.get(), i) );
+    elm_cache_map.prepare_elements_to_update();
+    for (unsigned int i : cell_idx)
+        elm_cache_map.mark_used_eval_points( DHCellAccessor(dh.get(), i), subset_idx, eval_points->subset_size(3, subset_idx) );
+    elm_cache_map.create_elements_points_map();
+    for (auto reg_it : elm_cache_map.update_cache_data().region_cache_indices_range_) {
+        batch_func.cache_update(batch_cache, elm_cache_map, reg_it.first);
+        point_func.cache_update(point_cache, elm_cache_map, reg_it.first);
+    }
+    elm_cache_map.finish_elements_update();
+
+    for (unsigned int i : cell_idx) {
+        DHCellAccessor cache_cell = elm_cache_map( DHCellAccessor(dh.get(), i) );
+        auto map = MappingP1<3,3>::element_map(cache_cell.elm());
+        for (BulkPoint q_point : mass_eval->points(cache_cell, &elm_cache_map)) {
+            arma::vec3 p = MappingP1<3,3>::project_unit_to_real(RefElement<3>::local_to_bary(q_point.loc_coords<3>()), map);
+            double expected = p(0) * p(1) * p(2);
+            EXPECT_DOUBLE_EQ( expected, batch_cache.get_value<FieldValue<3>::Scalar>(elm_cache_map, cache_cell, q_point.eval_point_idx()) );
+            EXPECT_DOUBLE_EQ( expected, point_cache.get_value<FieldValue<3>::Scalar>(elm_cache_map, cache_cell, q_point.eval_point_idx()) );
+        }
+    }
+
+    delete mesh;
+}
+
+
 TEST(FieldPython, read_from_input) {
     typedef FieldAlgorithmBase<3, FieldValue<3>::VectorFixed > VectorField;
     typedef FieldAlgorithmBase<3, FieldValue<3>::Scalar > ScalarField;
@@ -269,6 +269,7 @@ TEST_F(SomeEquation, input_related) {
     // time = 0.5
     data.set_time(tg.step(), LimitSide::right);
     EXPECT_FALSE(data.changed());
+    EXPECT_FALSE(data.changed(front_3d));
     EXPECT_FALSE(data.is_constant(front_3d));
     EXPECT_FALSE(tg.is_current(tg.marks().type_input()));
     tg.next_time();
@@ -276,6 +277,9 @@ TEST_F(SomeEquation, input_related) {
     // time = 1.0
     data.set_time(tg.step(), LimitSide::right);
     EXPECT_TRUE(data.changed());
+    EXPECT_TRUE(data.changed(front_3d));
+    EXPECT_TRUE(data.changed( mesh_->region_db().get_region_set("BULK") ));
+    EXPECT_FALSE(data.changed( mesh_->region_db().get_region_set(".BOUNDARY") ));
     EXPECT_TRUE(data.is_constant(front_3d));
     EXPECT_TRUE(tg.is_current(tg.marks().type_input()));
 
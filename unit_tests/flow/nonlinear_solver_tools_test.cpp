@@ -0,0 +1,96 @@
+/*
+ * nonlinear_solver_tools_test.cpp
+ *
+ */
+
+#define TEST_USE_PETSC
+
+#include <flow_gtest_mpi.hh>
+#include <cmath>
+#include <vector>
+
+#include "flow/nonlinear_solver_tools.hh"
+
+
+/**
+ * Scalar problem with the residual |x - 1|. The full step from x=0 to x=4 overshoots
+ * the solution, so the line search has to shorten it.
+ */
+class LineSearchTest : public testing::Test {
+protected:
+    LineSearchTest() {
+        VecCreateSeq(PETSC_COMM_SELF, 1, &solution_);
+        VecDuplicate(solution_, &prev_solution_);
+        VecSet(prev_solution_, 0.0);
+        VecSet(solution_, 4.0);
+    }
+
+    ~LineSearchTest() {
+        VecDestroy(&solution_);
+        VecDestroy(&prev_solution_);
+    }
+
+    double value() {
+        PetscScalar *x;
+        VecGetArray(solution_, &x);
+        double val = x[0];
+        VecRestoreArray(solution_, &x);
+        return val;
+    }
+
+    double residual() {
+        n_evaluations_++;
+        return std::abs(value() - 1.0);
+    }
+
+    double line_search(unsigned int max_steps) {
+        return backtracking_line_search(solution_, prev_solution_, residual(), 1.0, max_steps,
+                [this]() { return this->residual(); });
+    }
+
+    Vec solution_, prev_solution_;
+    unsigned int n_evaluations_ = 0;
+};
+
+
+TEST_F(LineSearchTest, backtracking) {
+    // 4 -> 2 -> 1
+    EXPECT_DOUBLE_EQ(0.0, line_search(5));
+    EXPECT_DOUBLE_EQ(1.0, value());
+    EXPECT_EQ(3u, n_evaluations_);
+}
+
+TEST_F(LineSearchTest, max_steps) {
+    EXPECT_DOUBLE_EQ(1.0, line_search(1));
+    EXPECT_DOUBLE_EQ(2.0, value());
+    EXPECT_EQ(2u, n_evaluations_);
+}
+
+TEST_F(LineSearchTest, switched_off) {
+    EXPECT_DOUBLE_EQ(3.0, line_search(0));
+    EXPECT_DOUBLE_EQ(4.0, value());
+    EXPECT_EQ(1u, n_evaluations_);
+}
+
+TEST_F(LineSearchTest, full_step_accepted) {
+    VecSet(solution_, 1.5);
+    EXPECT_DOUBLE_EQ(0.5, line_search(5));
+    EXPECT_DOUBLE_EQ(1.5, value());
+    EXPECT_EQ(1u, n_evaluations_);
+}
+
+
+TEST(EisenstatWalker, forcing_term) {
+    // first iteration keeps the initial forcing term
+    EXPECT_DOUBLE_EQ(0.1, eisenstat_walker_forcing_term({1.0}, 1.0, 0.1, 1e-10));
+
+    // fast decrease gives small forcing term
+    double eta = eisenstat_walker_forcing_term({1.0, 0.01}, 0.01, 0.1, 1e-10);
+    EXPECT_DOUBLE_EQ(0.9 * std::pow(0.01, 0.5*(1+std::sqrt(5.0))), eta);
+
+    // slow decrease is capped
+    EXPECT_DOUBLE_EQ(0.9, eisenstat_walker_forcing_term({1.0, 1.0}, 1.0, 0.1, 1e-10));
+
+    // no oversolving close to the nonlinear tolerance
+    EXPECT_DOUBLE_EQ(0.5, eisenstat_walker_forcing_term({1.0, 0.01}, 0.01, 0.1, 0.01));
+}
@@ -104,3 +104,40 @@ TEST(soil_model_Irmay, all) {
       check(soil_model, -1.00000000e+03, 2.92204588e-01, 5.32865027e-05, 5.24659003e-11, 3.34749654e-14);
       check(soil_model, -1.00000000e+04, 1.88528718e-01, 3.53702521e-06, 1.07164139e-11, 7.75481824e-16);
 }
+
+
+
+TEST(soil_model_Tabulated, van_genuchten) {
+    auto analytic = std::make_shared<SoilModel_VanGenuchten>();
+    SoilModelTabulated soil_model(analytic, 100, 1e-4);
+    SoilData soil_data;
+    soil_data.n = 1.24;
+    soil_data.alpha = 0.005;
+    soil_data.Qr = 0.04;
+    soil_data.Qs = 0.42;
+    soil_data.Ks = 1.8e-10;
+    soil_data.cut_fraction = 0.999;
+
+    soil_model.reset(soil_data);
+    EXPECT_LT(soil_model.table_error(), 1e-4);
+
+    for (double head : {1.0, 0.0, -1.0, -3.0, -10.0, -100.0, -1000.0, -1.0e4, -1.0e6, -1.0e10}) {
+        double cap, cap_ref;
+        double wc = soil_model.water_content_capacity(head, cap);
+        double wc_ref = analytic->water_content_capacity(head, cap_ref);
+        EXPECT_NEAR(wc_ref, wc, 1e-6 * wc_ref);
+        EXPECT_NEAR(cap_ref, cap, 1e-3 * cap_ref + 1e-15);
+        EXPECT_NEAR(wc_ref, soil_model.water_content(head), 1e-6 * wc_ref);
+
+        double cond_ref = analytic->conductivity(head);
+        EXPECT_NEAR(cond_ref, soil_model.conductivity(head), 1e-5 * cond_ref);
+    }
+
+    // table is reused for the same parameters
+    soil_data.n = 1.5;
+    soil_model.reset(soil_data);
+    EXPECT_NEAR(analytic->conductivity(-100.0), soil_model.conductivity(-100.0), 1e-5 * analytic->conductivity(-100.0));
+    soil_data.n = 1.24;
+    soil_model.reset(soil_data);
+    EXPECT_NEAR(analytic->conductivity(-100.0), soil_model.conductivity(-100.0), 1e-5 * analytic->conductivity(-100.0));
+}
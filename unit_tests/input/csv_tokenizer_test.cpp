@@ -0,0 +1,61 @@
+/*
+ * csv_tokenizer_test.cpp
+ *
+ */
+
+#define FEAL_OVERRIDE_ASSERTS
+
+#include <flow_gtest.hh>
+#include <sstream>
+#include <string>
+#include "input/csv_tokenizer.hh"
+#include "input/reader_internal_base.hh"
+
+using namespace std;
+
+string csv_input = R"CODE(idx X-coord name
+ 
+1, 0.5, "a b", 7
+2,,-1e-3 , "c,d"   
+
+3 ; 1.0 \"e\"
+)CODE";
+
+
+TEST(CSVTokenizer, read_values) {
+    istringstream is(csv_input);
+    CSVTokenizer tok(is, ",; \t");
+
+    EXPECT_EQ(4, tok.get_n_lines());
+    tok.skip_header(1);
+
+    EXPECT_TRUE( tok.next_line() );
+    EXPECT_EQ(3, tok.line_num());
+    EXPECT_EQ(1, tok.get_int_val()); ++tok;
+    EXPECT_EQ(0.5, tok.get_double_val()); ++tok;
+    EXPECT_EQ("a b", tok.get_string_val()); ++tok;
+    EXPECT_EQ(7, tok.get_int_val()); ++tok;
+    EXPECT_TRUE( tok.eol() );
+
+    EXPECT_TRUE( tok.next_line() );
+    EXPECT_EQ(4, tok.line_num());
+    EXPECT_EQ(2, tok.get_int_val()); ++tok;
+    EXPECT_EQ(-1e-3, tok.get_double_val());
+    EXPECT_THROW( tok.get_int_val(), Input::ReaderInternalBase::ExcWrongCsvFormat );
+    ++tok;
+    EXPECT_EQ("c,d", tok.get_string_val()); ++tok;
+    EXPECT_TRUE( tok.eol() );
+    EXPECT_THROW( tok.get_double_val(), Input::ReaderInternalBase::ExcWrongCsvFormat );
+
+    EXPECT_TRUE( tok.next_line() );
+    EXPECT_EQ(6, tok.line_num());
+    EXPECT_EQ(3, tok.get_int_val()); ++tok;
+    EXPECT_EQ(1.0, tok.get_double_val()); ++tok;
+    EXPECT_EQ("\"e\"", tok.get_string_val());
+    EXPECT_THROW( tok.get_double_val(), Input::ReaderInternalBase::ExcWrongCsvFormat );
+    ++tok;
+    EXPECT_TRUE( tok.eol() );
+
+    EXPECT_FALSE( tok.next_line() );
+    EXPECT_TRUE( tok.eol() );
+}
@@ -95,3 +95,30 @@ using namespace Input;
     EXPECT_THROW( {array.get_item(4)->get_array_size();}, ExcStorageTypeMismatch);
 }
 
+
+
+TEST(Storage, double_array) {
+using namespace Input;
+
+    StorageDoubleArray array({1.5, 2.5, 3.5});
+    EXPECT_EQ(3, array.get_array_size());
+    EXPECT_FALSE(array.is_null());
+    EXPECT_EQ(1.5, array.get_item(0)->get_double());
+    EXPECT_EQ(3.5, array.get_item(2)->get_double());
+    EXPECT_THROW( {array.get_item(1)->get_int();}, ExcStorageTypeMismatch);
+    EXPECT_THROW( {array.get_double();}, ExcStorageTypeMismatch);
+
+    array.set_item(1, new StorageDouble(-4.0));
+    EXPECT_EQ(-4.0, array.get_item(1)->get_double());
+
+    StorageBase *copy = array.deep_copy();
+    array.set_item(0, new StorageDouble(0.0));
+    EXPECT_EQ(3, copy->get_array_size());
+    EXPECT_EQ(1.5, copy->get_item(0)->get_double());
+    EXPECT_EQ(-4.0, copy->get_item(1)->get_double());
+    delete copy;
+
+#ifdef FLOW123D_DEBUG_ASSERTS
+    EXPECT_THROW_WHAT( {array.get_item(3);} , feal::Exc_assert, "Index is out of array");
+#endif
+}
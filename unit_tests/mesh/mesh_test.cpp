@@ -17,6 +17,7 @@
 #include <vector>
 #include "mesh/accessors.hh"
 #include "mesh/partitioning.hh"
+#include "mesh/mesh_geometry.hh"
 #include "input/reader_to_storage.hh"
 #include "system/sys_profiler.hh"
 
@@ -89,6 +90,87 @@ TEST(MeshTopology, make_neighbours_and_edges) {
 }
 
 
+TEST(MeshGeometry, simplest_cube) {
+    FilePath::set_io_dirs(".",UNIT_TESTS_SRC_DIR,"",".");
+    Profiler::instance();
+
+    Mesh * mesh = mesh_full_constructor("{mesh_file=\"mesh/simplest_cube.msh\"}");
+    EXPECT_EQ(nullptr, mesh->geometry());
+    delete mesh;
+
+    mesh = mesh_full_constructor("{mesh_file=\"mesh/simplest_cube.msh\", geometry_cache=true}");
+    const MeshGeometry *geometry = mesh->geometry();
+    ASSERT_NE(nullptr, geometry);
+    EXPECT_FALSE(geometry->contains(mesh->n_elements()));
+
+    const double factorial[] = {1, 1, 2, 6};
+    for (auto elm : mesh->elements_range()) {
+        unsigned int dim = elm.dim();
+        EXPECT_TRUE(geometry->contains(elm.mesh_idx()));
+        EXPECT_NEAR(elm.measure(), geometry->determinant(elm.mesh_idx()) / factorial[dim], 1e-12);
+
+        // sides of a closed simplex: sum of outer normals weighted by side measures vanishes
+        arma::vec3 sum_normals = arma::zeros(3);
+        for (unsigned int sid=0; sid<elm->n_sides(); sid++) {
+            double side_measure = elm.side(sid)->measure();
+            EXPECT_NEAR(side_measure, geometry->side_determinant(elm.mesh_idx(), sid) / factorial[dim-1], 1e-12);
+            arma::vec3 n = geometry->normal_vector(elm.mesh_idx(), sid);
+            EXPECT_NEAR(1.0, arma::norm(n, 2), 1e-12);
+            sum_normals += side_measure * n;
+        }
+        EXPECT_NEAR(0.0, arma::norm(sum_normals, 2), 1e-12);
+    }
+
+    // inverse Jacobian of a 3D element
+    ElementAccessor<3> elm = mesh->element_accessor(3);
+    arma::mat33 prod = geometry->inverse_jacobian<3>(elm.mesh_idx()) * geometry->jacobian<3>(elm.mesh_idx());
+    EXPECT_NEAR(0.0, arma::norm(prod - arma::eye(3,3), 2), 1e-12);
+
+    delete mesh;
+}
+
+
+TEST(Mesh, reorder_elements) {
+    FilePath::set_io_dirs(".",UNIT_TESTS_SRC_DIR,"",".");
+    Profiler::instance();
+
+    Mesh * mesh = mesh_full_constructor("{mesh_file=\"mesh/test_108_elem.msh\"}");
+    Mesh * reordered = mesh_full_constructor("{mesh_file=\"mesh/test_108_elem.msh\", reorder_elements=true}");
+    EXPECT_FALSE(mesh->elements_reordered());
+    EXPECT_TRUE(reordered->elements_reordered());
+
+    ASSERT_EQ(mesh->n_elements(), reordered->n_elements());
+    ASSERT_EQ(mesh->n_elements(true), reordered->n_elements(true));
+    ASSERT_EQ(mesh->n_nodes(), reordered->n_nodes());
+    EXPECT_EQ(mesh->n_edges(), reordered->n_edges());
+    EXPECT_EQ(mesh->n_vb_neighbours(), reordered->n_vb_neighbours());
+
+    // elements keep their IDs, regions and nodes
+    for (auto elm : mesh->elements_range()) {
+        int id = mesh->find_elem_id(elm.idx());
+        ElementAccessor<3> r_elm = reordered->element_accessor( reordered->elem_index(id) );
+        EXPECT_EQ(elm.region().id(), r_elm.region().id());
+        ASSERT_EQ(elm->n_nodes(), r_elm->n_nodes());
+        for (unsigned int i=0; i<elm->n_nodes(); i++) {
+            EXPECT_EQ( mesh->find_node_id(elm->node_idx(i)), reordered->find_node_id(r_elm->node_idx(i)) );
+            EXPECT_EQ( 0.0, arma::norm(*elm.node(i) - *r_elm.node(i), 1) );
+        }
+    }
+
+    // nodes are numbered in order of first use by elements
+    unsigned int next_node = 0;
+    for (auto elm : reordered->elements_range())
+        for (unsigned int i=0; i<elm->n_nodes(); i++) {
+            EXPECT_LE(elm->node_idx(i), next_node);
+            if (elm->node_idx(i) == next_node) next_node++;
+        }
+    EXPECT_EQ(reordered->n_nodes(), next_node);
+
+    delete reordered;
+    delete mesh;
+}
+
+
 const string mesh_input = R"YAML(
 mesh_file: "mesh/simplest_cube.msh"
 regions:
@@ -69,3 +69,35 @@ TEST(Partitioning, all) {
 
     delete mesh;
 }
+
+
+// Test input for mesh with weighted partitioning
+const string mesh_weighted_input = R"JSON(
+{ 
+  mesh_file="mesh/simplest_cube.msh",
+  partitioning={
+    tool="METIS",
+    graph_type="any_weight_lower_dim_cuts",
+    element_weights="couplings",
+    dimension_weights=[4, 2, 1]
+  }
+}
+)JSON";
+
+
+TEST(Partitioning, weighted) {
+    Profiler::instance();
+
+    FilePath::set_io_dirs(".",UNIT_TESTS_SRC_DIR,"",".");
+
+    Mesh * mesh = mesh_full_constructor(mesh_weighted_input);
+
+    const Distribution * init_ds = mesh->get_part()->get_init_distr();
+    const LongIdx * part = mesh->get_part()->get_loc_part();
+    for(unsigned int i=0; i < init_ds->lsize(); i++) {
+        EXPECT_GE(part[i], 0);
+        EXPECT_LT(part[i], (int)init_ds->np());
+    }
+
+    delete mesh;
+}
@@ -0,0 +1,58 @@
+/*
+ * arena_allocator_test.cpp
+ *
+ *  Test of Arena and ArenaAllocator.
+ */
+
+#include <flow_gtest.hh>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "system/arena_allocator.hh"
+
+
+TEST(Arena, allocate) {
+    internal::Arena arena(256);
+    EXPECT_EQ(0u, arena.capacity());
+
+    char *a = static_cast<char *>( arena.allocate(10, 1) );
+    char *b = static_cast<char *>( arena.allocate(8, 8) );
+    EXPECT_EQ(a + 16, b);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(b) % 8);
+    EXPECT_EQ(256u, arena.capacity());
+
+    // larger than the block size, new block of exact size
+    arena.allocate(1000);
+    EXPECT_EQ(1256u, arena.capacity());
+
+    // blocks are reused after reset
+    arena.reset();
+    EXPECT_EQ(a, arena.allocate(10, 1));
+    arena.allocate(1000);
+    EXPECT_EQ(1256u, arena.capacity());
+}
+
+
+TEST(Arena, map) {
+    typedef std::map<unsigned int, double, std::less<unsigned int>,
+            internal::ArenaAllocator<std::pair<const unsigned int, double>>> Map;
+    internal::Arena arena(1024);
+    Map map{std::less<unsigned int>(), Map::allocator_type(arena)};
+
+    std::size_t capacity = 0;
+    for (unsigned int step=0; step<10; step++) {
+        map.clear();
+        arena.reset();
+        for (unsigned int i=0; i<100; i++) map[(i*7) % 100] = i;
+        EXPECT_EQ(100u, map.size());
+        EXPECT_EQ(3.0, map[21]);
+        if (step == 0) capacity = arena.capacity();
+        // no new memory in next steps
+        EXPECT_EQ(capacity, arena.capacity());
+    }
+
+    std::vector<double, internal::ArenaAllocator<double>> vec{ internal::ArenaAllocator<double>(arena) };
+    vec.resize(10, 1.0);
+    EXPECT_EQ(1.0, vec[9]);
+}
@@ -6,6 +6,7 @@
  */
 
 #include <ctime>
+#include <cmath>
 #include <cstdlib>
 #include <sstream>
 
@@ -40,6 +41,7 @@ class ProfilerTest: public testing::Test {
         void test_petsc_memory_monitor();
         void test_multiple_instances();
         void test_propagate_values();
+        void test_perf_counters();
         // void test_inconsistent_tree();
 };
 
@@ -523,6 +525,38 @@ void ProfilerTest::test_propagate_values() {
     Profiler::uninitialize();
 }
 
+// hardware counters, checked only if the system allows to open them
+TEST_F(ProfilerTest, test_perf_counters) {test_perf_counters();}
+void ProfilerTest::test_perf_counters() {
+    Profiler::instance();
+    Profiler::set_perf_counters(true);
+    if (PerfCounters::is_active()) {
+        double sum = 0.0;
+        START_TIMER("perf");
+            for (int i = 0; i < 100000; i++) sum += sqrt(i);
+            EXPECT_GT(sum, 0.0);
+        END_TIMER("perf");
+
+        Timer &timer = PI->timers_[ PI->timers_[0].child_timers[ CODE_POINT("perf").hash_idx_ ] ];
+        EXPECT_GT(timer.perf_cumul_[PerfCounters::instructions], 100000u);
+        EXPECT_GT(timer.perf_cumul_[PerfCounters::cycles], 0u);
+        EXPECT_GT(timer.perf_ipc(), 0.0);
+    }
+
+    // collective, counters are reported only if active on all processes
+    std::stringstream sout;
+    PI->output(MPI_COMM_WORLD, sout);
+    int mpi_rank, local_active = PerfCounters::is_active(), all_active;
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Allreduce(&local_active, &all_active, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    if (mpi_rank == 0 && all_active) {
+        EXPECT_NE( sout.str().find("perf-instructions-sum"), string::npos );
+        EXPECT_NE( sout.str().find("perf-ipc-max"), string::npos );
+    }
+    Profiler::uninitialize();
+    EXPECT_FALSE(PerfCounters::is_active());
+}
+
 // optional test only for testing merging of inconsistent profiler trees
 // TEST_F(ProfilerTest, test_inconsistent_tree) {test_inconsistent_tree();}
 // void ProfilerTest::test_inconsistent_tree() {
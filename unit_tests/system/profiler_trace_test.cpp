@@ -0,0 +1,110 @@
+/*
+ * profiler_trace_test.cpp
+ *
+ *  Test of the timeline recording of timer spans.
+ */
+
+#define TEST_USE_MPI
+#include <flow_gtest_mpi.hh>
+
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+#include "system/profiler_trace.hh"
+#include "system/sys_profiler.hh"
+
+
+TEST(ProfilerTrace, disabled) {
+    ProfilerTrace::disable();
+    {
+        TraceFrame frame("disabled");
+    }
+    EXPECT_EQ(0u, ProfilerTrace::n_events());
+}
+
+
+TEST(ProfilerTrace, nested_spans) {
+    ProfilerTrace::enable(16);
+    {
+        TraceFrame outer("outer");
+        {
+            TraceFrame inner("inner", "sub");
+        }
+        ProfilerTrace::begin("closed_by_end");
+        ProfilerTrace::begin("closed_with_parent");
+        ProfilerTrace::end("closed_by_end");
+        // no such span
+        ProfilerTrace::end("unknown");
+    }
+    ASSERT_EQ(4u, ProfilerTrace::n_events());
+    EXPECT_STREQ("inner", ProfilerTrace::event(0).tag);
+    EXPECT_STREQ("sub", ProfilerTrace::event(0).subtag);
+    EXPECT_STREQ("closed_with_parent", ProfilerTrace::event(1).tag);
+    EXPECT_STREQ("closed_by_end", ProfilerTrace::event(2).tag);
+    EXPECT_STREQ("outer", ProfilerTrace::event(3).tag);
+
+    // inner span lies in the outer one
+    const ProfilerTrace::Event &in = ProfilerTrace::event(0), &out = ProfilerTrace::event(3);
+    EXPECT_LE(out.start, in.start);
+    EXPECT_GE(out.start + out.duration, in.start + in.duration);
+    ProfilerTrace::disable();
+}
+
+
+// spans are recorded with and without FLOW123D_DEBUG_PROFILER
+TEST(ProfilerTrace, timer_macros) {
+    Profiler::instance();
+    ProfilerTrace::enable(16);
+    { // uninitialize can not be in the same block as the START_TIMER
+        START_TIMER("macro_outer");
+        START_TIMER_EXT("macro_inner", "sub");
+        END_TIMER("macro_inner");
+    }
+    ASSERT_EQ(2u, ProfilerTrace::n_events());
+    EXPECT_STREQ("macro_inner", ProfilerTrace::event(0).tag);
+    EXPECT_STREQ("sub", ProfilerTrace::event(0).subtag);
+    EXPECT_STREQ("macro_outer", ProfilerTrace::event(1).tag);
+    ProfilerTrace::disable();
+    Profiler::uninitialize();
+}
+
+
+TEST(ProfilerTrace, ring_buffer) {
+    ProfilerTrace::enable(4);
+    const char *tags[] = {"a", "b", "c", "d", "e", "f"};
+    for (const char *tag : tags) {
+        TraceFrame frame(tag);
+    }
+    EXPECT_EQ(4u, ProfilerTrace::n_events());
+    EXPECT_EQ(2u, ProfilerTrace::n_lost_events());
+    EXPECT_STREQ("c", ProfilerTrace::event(0).tag);
+    EXPECT_STREQ("f", ProfilerTrace::event(3).tag);
+    ProfilerTrace::disable();
+}
+
+
+TEST(ProfilerTrace, output) {
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    ProfilerTrace::enable();
+    {
+        TraceFrame frame("output \"test\"");
+    }
+    std::string file_name = "profiler_trace_test.json";
+    ProfilerTrace::output(MPI_COMM_WORLD, file_name);
+    ProfilerTrace::disable();
+
+    if (rank == 0) {
+        std::ifstream is(file_name);
+        std::stringstream ss;
+        ss << is.rdbuf();
+        std::string content = ss.str();
+        EXPECT_EQ(0u, content.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+        EXPECT_NE(std::string::npos, content.find("\"name\":\"output \\\"test\\\"\",\"ph\":\"X\""));
+        for (int r=0; r<size; r++)
+            EXPECT_NE(std::string::npos, content.find("\"name\":\"rank " + std::to_string(r) + "\""));
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * step_metrics_test.cpp
+ *
+ *  Test of per time step metrics stream.
+ */
+
+#define TEST_USE_MPI
+#define TEST_USE_PETSC
+#define FEAL_OVERRIDE_ASSERTS
+#include <flow_gtest_mpi.hh>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "system/system.hh"
+#include "system/file_path.hh"
+#include "tools/time_governor.hh"
+#include "tools/step_metrics.hh"
+
+
+TEST(StepMetrics, phase_timer) {
+    StepMetrics metrics;
+    {
+        // not active, nothing measured
+        StepMetrics::PhaseTimer timer(metrics, StepMetrics::assembly);
+    }
+    metrics.add_linear_solve(10);
+    metrics.add_nonlinear_iterations(2);
+    EXPECT_FALSE(StepMetrics::is_active());
+}
+
+
+TEST(StepMetrics, stream) {
+    FilePath::set_io_dirs(".", UNIT_TESTS_SRC_DIR, "", ".");
+    StepMetrics::set_file("step_metrics_test.jsonl");
+    ASSERT_TRUE(StepMetrics::is_active());
+
+    {
+        TimeGovernor tg(0.0, 0.5);
+        tg.view("TEST");
+        for (unsigned int i=0; i<2; i++) {
+            tg.next_time();
+            {
+                StepMetrics::PhaseTimer timer(tg.metrics(), StepMetrics::solve);
+                tg.metrics().add_linear_solve(5);
+                tg.metrics().add_linear_solve(7);
+            }
+            tg.metrics().add_nonlinear_iterations(3);
+        }
+    }
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank == 0) {
+        std::ifstream is("step_metrics_test.jsonl");
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(is, line)) lines.push_back(line);
+
+        // initial step, two steps of next_time(), last step written by destructor
+        ASSERT_EQ(3u, lines.size());
+        EXPECT_EQ(0u, lines[0].find("{\"equation\":\"TEST\",\"step\":0,\"time\":0"));
+        EXPECT_NE(std::string::npos, lines[0].find("\"linear_solves\":0,"));
+        EXPECT_EQ(0u, lines[1].find("{\"equation\":\"TEST\",\"step\":1,\"time\":0.5,\"dt\":0.5,"));
+        EXPECT_NE(std::string::npos, lines[1].find("\"linear_solves\":2,\"linear_iterations\":12,\"nonlinear_iterations\":3"));
+        EXPECT_NE(std::string::npos, lines[2].find("\"step\":2,\"time\":1"));
+        EXPECT_NE(std::string::npos, lines[2].find("\"imbalance\":"));
+    }
+}